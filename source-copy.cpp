@@ -1,21 +1,53 @@
 #include "source-copy.hpp"
 #include <obs-module.h>
+#include <QApplication>
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
 #include <QClipboard>
+#include <QDataStream>
+#include <QDateTime>
 #include <QDesktopServices>
+#include <QDialog>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include <QFileDialog>
 #include <QGuiApplication>
+#include <QInputDialog>
 #include <QLabel>
 #include <QLineEdit>
+#include <QListWidget>
 #include <QMainWindow>
 #include <QMenu>
+#include <QMessageBox>
+#include <QMimeData>
+#include <QPointer>
+#include <QProgressDialog>
+#include <QRegularExpression>
+#include <QTimer>
+#include <QVBoxLayout>
 #include <QWidgetAction>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "obs-websocket-api.h"
 #include "util/config-file.h"
 #include "util/platform.h"
 #include "version.h"
 
-#ifndef _WIN32
+#ifdef _WIN32
+#include <windows.h>
+#else
 #include <dlfcn.h>
 #endif
 
@@ -27,244 +59,2148 @@ OBS_MODULE_AUTHOR("Exeldro");
 OBS_MODULE_USE_DEFAULT_LOCALE("source-copy", "en-US")
 
 #define MAX_PATH 260
+#define IMPORT_BATCH_SIZE 25
+#define STREAM_CHUNK_SIZE (1024 * 1024)
+#define FIND_MAX_RESULTS 100
+#define CHANGE_EVENT_INTERVAL_MS 100
+#define SCENE_DIFF_MAX_REVISIONS 32
+
+#define BUNDLE_MIME_TYPE "application/x-obs-source-copy-bundle"
+#define BUNDLE_EXTENSION ".obsbundle"
+#define FILE_FILTER "JSON File (*.json);;Source Copy Bundle (*.obsbundle)"
+
+#define ARCHIVE_MAGIC 0x53434152
+#define ARCHIVE_VERSION 1
+#define ARCHIVE_END 0
+#define ARCHIVE_SETTINGS 1
+#define ARCHIVE_ASSET 2
+#define ARCHIVE_CHUNK_SIZE (1024 * 1024)
+#define ARCHIVE_FILTER "Source Copy Archive (*.obsarchive)"
+#define PARAMETER_FILTER "Parameter Table (*.csv *.json)"
 
 static bool replace(std::string &str, const char *from, const char *to)
 {
-	size_t start_pos = str.find(from);
-	if (start_pos == std::string::npos)
+	size_t start_pos = str.find(from);
+	if (start_pos == std::string::npos)
+		return false;
+	str.replace(start_pos, strlen(from), to);
+	return true;
+}
+
+class JsonScanner {
+	std::vector<std::string> path;
+	bool elements;
+	std::vector<char> stack;
+	std::vector<std::string> keys;
+	bool in_string = false;
+	bool escape = false;
+	bool collect = false;
+	bool expect_key = false;
+	std::string str;
+	bool capturing = false;
+	size_t capture_depth = 0;
+	size_t array_depth = 0;
+	std::string capture;
+
+	bool AtPath() const
+	{
+		if (stack.size() != path.size())
+			return false;
+		for (size_t i = 0; i < path.size(); i++) {
+			if (stack[i] != '{' || keys[i] != path[i])
+				return false;
+		}
+		return true;
+	}
+
+public:
+	// Captures the raw JSON text of the value at the object key path, or of each
+	// object in the array at that path when elements is set.
+	JsonScanner(std::vector<std::string> path_, bool elements_) : path(std::move(path_)), elements(elements_) {}
+
+	// Returns false once the value at the path has been fully read.
+	bool Feed(const char *data, size_t size, const std::function<void(std::string &value)> &callback)
+	{
+		for (size_t i = 0; i < size; i++) {
+			const char c = data[i];
+			if (capturing)
+				capture.push_back(c);
+			if (in_string) {
+				if (escape) {
+					escape = false;
+				} else if (c == '\\') {
+					escape = true;
+				} else if (c == '"') {
+					in_string = false;
+					if (collect) {
+						keys.back() = str;
+						collect = false;
+					}
+					continue;
+				}
+				if (collect)
+					str.push_back(c);
+				continue;
+			}
+			switch (c) {
+			case '"':
+				in_string = true;
+				collect = expect_key && stack.size() <= path.size();
+				expect_key = false;
+				str.clear();
+				break;
+			case ',':
+				expect_key = !stack.empty() && stack.back() == '{';
+				break;
+			case '{':
+			case '[':
+				if (!capturing && !array_depth && AtPath()) {
+					if (elements && c == '[') {
+						array_depth = stack.size() + 1;
+					} else if (!elements) {
+						capturing = true;
+						capture_depth = stack.size();
+						capture.assign(1, c);
+					}
+				} else if (!capturing && array_depth && c == '{' && stack.size() == array_depth) {
+					capturing = true;
+					capture_depth = stack.size();
+					capture.assign(1, c);
+				}
+				stack.push_back(c);
+				keys.emplace_back();
+				expect_key = c == '{';
+				break;
+			case '}':
+			case ']':
+				if (stack.empty())
+					return false;
+				stack.pop_back();
+				keys.pop_back();
+				expect_key = false;
+				if (capturing && stack.size() == capture_depth) {
+					capturing = false;
+					callback(capture);
+					capture.clear();
+					if (!elements)
+						return false;
+				} else if (array_depth && stack.size() + 1 == array_depth) {
+					return false;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		return true;
+	}
+};
+
+config_t *get_user_config(void)
+{
+	return obs_frontend_get_user_config();
+}
+
+struct PathCandidate {
+	obs_data_t *owner;
+	std::string key;
+	std::string value;
+};
+
+static void collect_path_candidates(obs_data_t *data, std::vector<PathCandidate> &candidates)
+{
+	obs_data_item_t *item = obs_data_first(data);
+	while (item) {
+		const enum obs_data_type type = obs_data_item_gettype(item);
+		if (type == OBS_DATA_STRING) {
+			const char *str = obs_data_item_get_string(item);
+			if (str && (strchr(str, '/') || strchr(str, '\\') || strstr(str, "[U_COMBOBULATOR_PATH]"))) {
+				obs_data_addref(data);
+				candidates.push_back({data, obs_data_item_get_name(item), str});
+			}
+		} else if (type == OBS_DATA_OBJECT) {
+			if (obs_data_t *obj = obs_data_item_get_obj(item)) {
+				collect_path_candidates(obj, candidates);
+				obs_data_release(obj);
+			}
+		} else if (type == OBS_DATA_ARRAY) {
+			const auto array = obs_data_item_get_array(item);
+			const auto count = obs_data_array_count(array);
+			for (size_t i = 0; i < count; i++) {
+				if (obs_data_t *obj = obs_data_array_item(array, i)) {
+					collect_path_candidates(obj, candidates);
+					obs_data_release(obj);
+				}
+			}
+			obs_data_array_release(array);
+		}
+		obs_data_item_next(&item);
+	}
+}
+
+static std::string fold_path_case(std::string path)
+{
+	std::transform(path.begin(), path.end(), path.begin(), [](unsigned char c) { return (char)tolower(c); });
+	return path;
+}
+
+class PathIndex {
+	struct Dir {
+		qint64 mtime = -1;
+		uint64_t checked = 0;
+		// (folded) file or folder name -> name on disk
+		std::unordered_map<std::string, std::string> names;
+	};
+
+	std::string root;
+	bool fold_case;
+	uint64_t load = 0;
+	// directory relative to root -> its listing
+	std::unordered_map<std::string, Dir> dirs;
+	// (folded) path relative to root -> absolute path, empty when not found; only kept for one load
+	std::unordered_map<std::string, std::string> resolved;
+
+	static qint64 GetModified(const std::string &path)
+	{
+		const QFileInfo info(QT_UTF8(path.c_str()));
+		return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+	}
+
+	// Lists a directory once, and again in a later load when its modification time changed.
+	const std::unordered_map<std::string, std::string> &GetDir(const std::string &relative)
+	{
+		Dir &dir = dirs[relative];
+		if (dir.checked == load)
+			return dir.names;
+		dir.checked = load;
+		const std::string path = root + relative;
+		const qint64 mtime = GetModified(path);
+		if (mtime == dir.mtime && mtime != -1)
+			return dir.names;
+		dir.mtime = mtime;
+		dir.names.clear();
+		os_dir_t *d = os_opendir(path.c_str());
+		if (!d)
+			return dir.names;
+		while (struct os_dirent *ent = os_readdir(d)) {
+			if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0)
+				continue;
+			dir.names.emplace(fold_case ? fold_path_case(ent->d_name) : std::string(ent->d_name), ent->d_name);
+		}
+		os_closedir(d);
+		return dir.names;
+	}
+
+public:
+	PathIndex(std::string root_, bool fold_case_) : root(std::move(root_)), fold_case(fold_case_) {}
+
+	const std::string &Root() const { return root; }
+	bool FoldCase() const { return fold_case; }
+
+	// Starts a new load action: misses of earlier loads are looked up again and changed directories are listed again.
+	void BeginLoad()
+	{
+		load++;
+		resolved.clear();
+	}
+
+	const std::string &Find(std::string relative)
+	{
+		std::replace(relative.begin(), relative.end(), '\\', '/');
+		if (fold_case)
+			relative = fold_path_case(relative);
+		auto it = resolved.find(relative);
+		if (it != resolved.end())
+			return it->second;
+
+		std::string &result = resolved[relative];
+		std::string disk_path;
+		std::size_t start = 0;
+		while (start < relative.length()) {
+			std::size_t slash = relative.find('/', start);
+			const bool last = slash == std::string::npos;
+			const std::string name = relative.substr(start, last ? std::string::npos : slash - start);
+			const auto &names = GetDir(disk_path);
+			auto entry = names.find(name);
+			if (entry == names.end())
+				return result;
+			disk_path += entry->second;
+			if (last)
+				break;
+			disk_path += "/";
+			start = slash + 1;
+		}
+		if (disk_path.empty() || disk_path.back() == '/')
+			return result;
+
+		char path_buffer[MAX_PATH];
+		const std::string path = root + disk_path;
+		if (os_get_abs_path(path.c_str(), path_buffer, MAX_PATH)) {
+			for (auto i = 0; path_buffer[i] != '\0'; i++)
+				if (path_buffer[i] == '\\')
+					path_buffer[i] = '/';
+			result = path_buffer;
+		}
+		return result;
+	}
+};
+
+static std::shared_ptr<PathIndex> path_index;
+
+static std::shared_ptr<PathIndex> GetPathIndex(const std::string &root)
+{
+	const auto config = get_user_config();
+	const bool fold_case = config && config_get_bool(config, "SourceCopy", "CaseInsensitivePaths");
+	if (!path_index || path_index->Root() != root || path_index->FoldCase() != fold_case)
+		path_index = std::make_shared<PathIndex>(root, fold_case);
+	path_index->BeginLoad();
+	return path_index;
+}
+
+static bool relocate_path(std::string &str, PathIndex &index, const std::vector<std::string> &prefixes)
+{
+	bool edit = replace(str, "[U_COMBOBULATOR_PATH]", (index.Root() + prefixes.front()).c_str());
+	bool local_url = false;
+	std::string path = str;
+	if (path.substr(0, 7) == "file://") {
+		path = path.substr(7);
+		local_url = true;
+	}
+	const std::size_t last = path.find_last_of("/\\");
+	if (path.length() >= MAX_PATH || last == std::string::npos || os_file_exists(path.c_str()))
+		return edit;
+
+	for (const auto &prefix : prefixes) {
+		std::size_t found = last;
+		while (found != std::string::npos) {
+			auto file = found == 0 && path[0] != '/' && path[0] != '\\' ? path : path.substr(found + 1);
+			if (file.find('.') == std::string::npos)
+				break;
+			const std::string &newFile = index.Find(prefix + file);
+			if (!newFile.empty()) {
+				str = local_url ? "file://" : "";
+				str += newFile;
+				return true;
+			}
+			if (found == 0) {
+				found = std::string::npos;
+			} else {
+				found = path.find_last_of("/\\", found - 1);
+				if (found == std::string::npos) {
+					found = 0;
+				}
+			}
+		}
+	}
+	return edit;
+}
+
+static void try_fix_paths(obs_data_t *data, PathIndex &index, const std::vector<std::string> &prefixes)
+{
+	std::vector<PathCandidate> candidates;
+	collect_path_candidates(data, candidates);
+
+	for (auto &candidate : candidates) {
+		if (relocate_path(candidate.value, index, prefixes))
+			obs_data_set_string(candidate.owner, candidate.key.c_str(), candidate.value.c_str());
+		obs_data_release(candidate.owner);
+	}
+}
+
+// Starts a load from fileName, returning the index of its folder and the prefixes to look for assets under.
+static std::shared_ptr<PathIndex> BeginPathLoad(const QString &fileName, std::vector<std::string> &prefixes)
+{
+	std::string dir = QT_TO_UTF8(fileName);
+	const std::size_t slash = dir.find_last_of("/\\");
+	if (slash != std::string::npos) {
+		auto point = dir.find_last_of('.');
+		if (point != std::string::npos && point > slash)
+			prefixes.push_back(dir.substr(slash + 1, point - slash - 1) + "/");
+		dir = dir.substr(0, slash + 1);
+	}
+	prefixes.push_back("");
+	return GetPathIndex(dir);
+}
+
+static void try_fix_paths(obs_data_t *data, QString fileName)
+{
+	if (!data)
+		return;
+	std::vector<std::string> prefixes;
+	auto index = BeginPathLoad(fileName, prefixes);
+	try_fix_paths(data, *index, prefixes);
+}
+
+static void LoadSourceMenu(QMenu *menu, obs_source_t *source, obs_sceneitem_t *item);
+static void LoadFilterMenu(QMenu *submenu, obs_source_t *child);
+static obs_data_t *SaveCanvases();
+static void DisconnectChangeEvents();
+
+static QCborMap DataToCbor(obs_data_t *data)
+{
+	QCborMap map;
+	obs_data_item_t *item = obs_data_first(data);
+	while (item) {
+		if (!obs_data_item_has_user_value(item)) {
+			obs_data_item_next(&item);
+			continue;
+		}
+		const QString name = QT_UTF8(obs_data_item_get_name(item));
+		switch (obs_data_item_gettype(item)) {
+		case OBS_DATA_STRING:
+			map[name] = QT_UTF8(obs_data_item_get_string(item));
+			break;
+		case OBS_DATA_NUMBER:
+			if (obs_data_item_numtype(item) == OBS_DATA_NUM_DOUBLE)
+				map[name] = obs_data_item_get_double(item);
+			else
+				map[name] = (qint64)obs_data_item_get_int(item);
+			break;
+		case OBS_DATA_BOOLEAN:
+			map[name] = obs_data_item_get_bool(item);
+			break;
+		case OBS_DATA_OBJECT:
+			if (obs_data_t *obj = obs_data_item_get_obj(item)) {
+				map[name] = DataToCbor(obj);
+				obs_data_release(obj);
+			}
+			break;
+		case OBS_DATA_ARRAY:
+			if (obs_data_array_t *array = obs_data_item_get_array(item)) {
+				QCborArray cborArray;
+				const size_t count = obs_data_array_count(array);
+				for (size_t i = 0; i < count; i++) {
+					obs_data_t *obj = obs_data_array_item(array, i);
+					cborArray.append(DataToCbor(obj));
+					obs_data_release(obj);
+				}
+				map[name] = cborArray;
+				obs_data_array_release(array);
+			}
+			break;
+		default:
+			break;
+		}
+		obs_data_item_next(&item);
+	}
+	return map;
+}
+
+static obs_data_t *CborToData(const QCborMap &map)
+{
+	obs_data_t *data = obs_data_create();
+	for (auto it = map.begin(); it != map.end(); ++it) {
+		const QByteArray name = it.key().toString().toUtf8();
+		const QCborValue value = it.value();
+		if (value.isString()) {
+			obs_data_set_string(data, name.constData(), QT_TO_UTF8(value.toString()));
+		} else if (value.isInteger()) {
+			obs_data_set_int(data, name.constData(), value.toInteger());
+		} else if (value.isDouble()) {
+			obs_data_set_double(data, name.constData(), value.toDouble());
+		} else if (value.isBool()) {
+			obs_data_set_bool(data, name.constData(), value.toBool());
+		} else if (value.isMap()) {
+			obs_data_t *obj = CborToData(value.toMap());
+			obs_data_set_obj(data, name.constData(), obj);
+			obs_data_release(obj);
+		} else if (value.isArray()) {
+			obs_data_array_t *array = obs_data_array_create();
+			for (const auto &element : value.toArray()) {
+				if (!element.isMap())
+					continue;
+				obs_data_t *obj = CborToData(element.toMap());
+				obs_data_array_push_back(array, obj);
+				obs_data_release(obj);
+			}
+			obs_data_set_array(data, name.constData(), array);
+			obs_data_array_release(array);
+		}
+	}
+	return data;
+}
+
+static QByteArray EncodeBundle(obs_data_t *data)
+{
+	return QCborValue(QCborKnownTags::Signature, DataToCbor(data)).toCbor();
+}
+
+static obs_data_t *DecodeBundle(const QByteArray &bytes)
+{
+	QCborParserError error;
+	QCborValue value = QCborValue::fromCbor(bytes, &error);
+	if (error.error != QCborError::NoError)
+		return nullptr;
+	if (value.isTag())
+		value = value.taggedValue();
+	if (!value.isMap())
+		return nullptr;
+	return CborToData(value.toMap());
+}
+
+static void SetClipboardData(obs_data_t *data)
+{
+	auto mimeData = new QMimeData;
+	mimeData->setText(QT_UTF8(obs_data_get_json(data)));
+	mimeData->setData(BUNDLE_MIME_TYPE, EncodeBundle(data));
+	QGuiApplication::clipboard()->setMimeData(mimeData);
+}
+
+static obs_data_t *GetClipboardData()
+{
+	const QMimeData *mimeData = QGuiApplication::clipboard()->mimeData();
+	if (!mimeData)
+		return nullptr;
+	if (mimeData->hasFormat(BUNDLE_MIME_TYPE)) {
+		if (obs_data_t *data = DecodeBundle(mimeData->data(BUNDLE_MIME_TYPE)))
+			return data;
+	}
+	const QString strData = mimeData->text();
+	if (strData.isEmpty())
+		return nullptr;
+	return obs_data_create_from_json(QT_TO_UTF8(strData));
+}
+
+static bool SaveDataFile(obs_data_t *data, const QString &fileName)
+{
+	if (!fileName.endsWith(BUNDLE_EXTENSION, Qt::CaseInsensitive))
+		return obs_data_save_json(data, QT_TO_UTF8(fileName));
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return false;
+	const QByteArray bytes = EncodeBundle(data);
+	return file.write(bytes) == bytes.size();
+}
+
+static obs_data_t *LoadDataFile(const QString &fileName)
+{
+	if (!fileName.endsWith(BUNDLE_EXTENSION, Qt::CaseInsensitive))
+		return obs_data_create_from_json_file(QT_TO_UTF8(fileName));
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return nullptr;
+	return DecodeBundle(file.readAll());
+}
+
+static bool SaveArchive(obs_data_t *data, const QString &fileName)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		return false;
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_6_0);
+	stream << (quint32)ARCHIVE_MAGIC << (quint32)ARCHIVE_VERSION;
+	stream << (quint8)ARCHIVE_SETTINGS << qCompress(QByteArray(obs_data_get_json(data)));
+
+	std::vector<PathCandidate> candidates;
+	collect_path_candidates(data, candidates);
+	for (auto &candidate : candidates)
+		obs_data_release(candidate.owner);
+	std::unordered_set<std::string> written;
+	std::vector<char> buffer(ARCHIVE_CHUNK_SIZE);
+	for (auto &candidate : candidates) {
+		std::string path = candidate.value;
+		if (path.substr(0, 7) == "file://")
+			path = path.substr(7);
+		const QFileInfo info(QT_UTF8(path.c_str()));
+		if (!info.isFile() || !written.emplace(path).second)
+			continue;
+		// An archive missing an asset its settings use would not restore the scene, so fail the save instead.
+		QFile asset(info.absoluteFilePath());
+		if (!asset.open(QIODevice::ReadOnly)) {
+			blog(LOG_WARNING, "[Source Copy] Failed to open '%s' for the archive", path.c_str());
+			file.remove();
+			return false;
+		}
+		const quint64 size = (quint64)asset.size();
+		stream << (quint8)ARCHIVE_ASSET << QByteArray(path.c_str()) << size;
+		quint64 remaining = size;
+		while (remaining) {
+			const qint64 chunk = (qint64)std::min<quint64>(remaining, ARCHIVE_CHUNK_SIZE);
+			const qint64 read = asset.read(buffer.data(), chunk);
+			if (read <= 0) {
+				blog(LOG_WARNING, "[Source Copy] Failed to read '%s' into the archive", path.c_str());
+				file.remove();
+				return false;
+			}
+			stream.writeRawData(buffer.data(), (int)read);
+			remaining -= (quint64)read;
+		}
+	}
+	stream << (quint8)ARCHIVE_END;
+	if (stream.status() != QDataStream::Ok) {
+		file.remove();
+		return false;
+	}
+	return true;
+}
+
+static QString UniqueAssetPath(const QDir &dir, const QString &name, std::unordered_set<std::string> &used)
+{
+	const QFileInfo info(name);
+	QString candidate = name;
+	for (int i = 2; QFile::exists(dir.filePath(candidate)) || used.count(QT_TO_UTF8(candidate)); i++) {
+		candidate = info.completeBaseName() + "_" + QString::number(i);
+		if (!info.suffix().isEmpty())
+			candidate += "." + info.suffix();
+	}
+	used.emplace(QT_TO_UTF8(candidate));
+	return dir.filePath(candidate);
+}
+
+static obs_data_t *LoadArchive(const QString &fileName, const QString &assetDir)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return nullptr;
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_6_0);
+	quint32 magic = 0, version = 0;
+	stream >> magic >> version;
+	if (magic != ARCHIVE_MAGIC || version > ARCHIVE_VERSION)
+		return nullptr;
+
+	QDir dir(assetDir);
+	dir.mkpath(".");
+	obs_data_t *data = nullptr;
+	std::unordered_map<std::string, std::string> paths;
+	std::unordered_set<std::string> used;
+	std::vector<QString> extracted;
+	std::vector<char> buffer(ARCHIVE_CHUNK_SIZE);
+	bool ok = true;
+	while (ok && stream.status() == QDataStream::Ok) {
+		quint8 type = ARCHIVE_END;
+		stream >> type;
+		if (type == ARCHIVE_SETTINGS) {
+			QByteArray compressed;
+			stream >> compressed;
+			obs_data_release(data);
+			data = obs_data_create_from_json(qUncompress(compressed).constData());
+		} else if (type == ARCHIVE_ASSET) {
+			QByteArray path;
+			quint64 size = 0;
+			stream >> path >> size;
+			const QString name = QFileInfo(QString::fromUtf8(path).replace('\\', '/')).fileName();
+			const QString target = UniqueAssetPath(dir, name.isEmpty() ? QString("asset") : name, used);
+			QFile asset(target);
+			ok = asset.open(QIODevice::WriteOnly | QIODevice::Truncate);
+			while (ok && size) {
+				const int chunk = (int)std::min<quint64>(size, ARCHIVE_CHUNK_SIZE);
+				ok = stream.readRawData(buffer.data(), chunk) == chunk &&
+				     asset.write(buffer.data(), chunk) == chunk;
+				size -= (quint64)chunk;
+			}
+			if (ok) {
+				extracted.push_back(target);
+				paths.emplace(path.constData(), QT_TO_UTF8(QFileInfo(target).absoluteFilePath()));
+			} else {
+				blog(LOG_WARNING, "[Source Copy] Failed to extract '%s' from the archive to '%s'", path.constData(),
+				     QT_TO_UTF8(target));
+				asset.remove();
+			}
+		} else {
+			break;
+		}
+	}
+	if (!ok || !data) {
+		// Don't leave the assets of an archive that failed to load behind.
+		for (const QString &target : extracted)
+			QFile::remove(target);
+		obs_data_release(data);
+		return nullptr;
+	}
+
+	std::vector<PathCandidate> candidates;
+	collect_path_candidates(data, candidates);
+	for (auto &candidate : candidates) {
+		const bool local_url = candidate.value.substr(0, 7) == "file://";
+		auto it = paths.find(local_url ? candidate.value.substr(7) : candidate.value);
+		if (it != paths.end()) {
+			const std::string value = local_url ? "file://" + it->second : it->second;
+			obs_data_set_string(candidate.owner, candidate.key.c_str(), value.c_str());
+		}
+		obs_data_release(candidate.owner);
+	}
+	return data;
+}
+
+static void ShowArchiveError(const char *text)
+{
+	const auto main_window = static_cast<QMainWindow *>(obs_frontend_get_main_window());
+	QMessageBox::warning(main_window, QT_UTF8(obs_module_text("SourceCopy")), QT_UTF8(obs_module_text(text)));
+}
+
+static QString GetArchiveAssetDir(const QString &fileName)
+{
+	const QFileInfo info(fileName);
+	return QFileDialog::getExistingDirectory(nullptr, QT_UTF8(obs_module_text("SelectAssetFolder")),
+						 QDir(info.absolutePath()).filePath(info.completeBaseName()));
+}
+
+static uint64_t HashString(const char *str)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	for (; *str; str++) {
+		hash ^= (uint8_t)*str;
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+static void CanonicalizeData(obs_data_t *data, std::string &out);
+
+static void CanonicalizeItem(obs_data_item_t *item, std::string &out)
+{
+	switch (obs_data_item_gettype(item)) {
+	case OBS_DATA_STRING: {
+		const char *str = obs_data_item_get_string(item);
+		out += 's';
+		out += std::to_string(strlen(str));
+		out += ':';
+		out += str;
+		break;
+	}
+	case OBS_DATA_NUMBER: {
+		// Compare numbers by value, a double that happens to be whole may come back from json as an int.
+		char number[32];
+		snprintf(number, sizeof(number), "n%.17g", obs_data_item_get_double(item));
+		out += number;
+		break;
+	}
+	case OBS_DATA_BOOLEAN:
+		out += obs_data_item_get_bool(item) ? "t" : "f";
+		break;
+	case OBS_DATA_OBJECT: {
+		obs_data_t *obj = obs_data_item_get_obj(item);
+		CanonicalizeData(obj, out);
+		obs_data_release(obj);
+		break;
+	}
+	case OBS_DATA_ARRAY: {
+		obs_data_array_t *array = obs_data_item_get_array(item);
+		out += '[';
+		const size_t count = obs_data_array_count(array);
+		for (size_t i = 0; i < count; i++) {
+			obs_data_t *obj = obs_data_array_item(array, i);
+			CanonicalizeData(obj, out);
+			obs_data_release(obj);
+		}
+		out += ']';
+		obs_data_array_release(array);
+		break;
+	}
+	default:
+		out += '-';
+		break;
+	}
+}
+
+// Serialize only user values with sorted keys, so the result does not depend on key order or defaults.
+static void CanonicalizeData(obs_data_t *data, std::string &out)
+{
+	if (!data) {
+		out += '-';
+		return;
+	}
+	std::vector<std::string> names;
+	for (obs_data_item_t *item = obs_data_first(data); item; obs_data_item_next(&item)) {
+		if (obs_data_item_has_user_value(item))
+			names.emplace_back(obs_data_item_get_name(item));
+	}
+	std::sort(names.begin(), names.end());
+	out += '{';
+	for (const auto &name : names) {
+		obs_data_item_t *item = obs_data_item_byname(data, name.c_str());
+		out += name;
+		out += '=';
+		CanonicalizeItem(item, out);
+		out += ';';
+		obs_data_item_release(&item);
+	}
+	out += '}';
+}
+
+// Stable hash of the saved settings and filters of a source, as exported under "content_hash".
+static std::string ContentHash(obs_data_t *sourceData)
+{
+	std::string canonical = obs_data_get_string(sourceData, "id");
+	obs_data_t *settings = obs_data_get_obj(sourceData, "settings");
+	CanonicalizeData(settings, canonical);
+	obs_data_release(settings);
+	obs_data_array_t *filters = obs_data_get_array(sourceData, "filters");
+	const size_t count = obs_data_array_count(filters);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *filter = obs_data_array_item(filters, i);
+		canonical += '|';
+		canonical += obs_data_get_string(filter, "id");
+		canonical += '|';
+		canonical += obs_data_get_string(filter, "name");
+		canonical += obs_data_get_bool(filter, "enabled") ? "|t" : "|f";
+		settings = obs_data_get_obj(filter, "settings");
+		CanonicalizeData(settings, canonical);
+		obs_data_release(settings);
+		obs_data_release(filter);
+	}
+	obs_data_array_release(filters);
+	char hash[17];
+	snprintf(hash, sizeof(hash), "%016llx", (unsigned long long)HashString(canonical.c_str()));
+	return hash;
+}
+
+static std::string GetContentHash(obs_source_t *source)
+{
+	obs_data_t *data = obs_save_source(source);
+	std::string hash = ContentHash(data);
+	obs_data_release(data);
+	return hash;
+}
+
+static obs_data_t *SaveSourceData(obs_source_t *source)
+{
+	obs_data_t *data = obs_save_source(source);
+	if (data)
+		obs_data_set_string(data, "content_hash", ContentHash(data).c_str());
+	return data;
+}
+
+static bool PatchSettings(obs_source_t *source, obs_data_t *data)
+{
+	bool changed = false;
+	obs_data_t *settings = obs_data_get_obj(data, "settings");
+	if (settings) {
+		obs_data_t *current = obs_source_get_settings(source);
+		if (strcmp(obs_data_get_json(current), obs_data_get_json(settings)) != 0) {
+			obs_source_reset_settings(source, settings);
+			changed = true;
+		}
+		obs_data_release(current);
+		obs_data_release(settings);
+	}
+	if (obs_data_has_user_value(data, "enabled") && obs_source_enabled(source) != obs_data_get_bool(data, "enabled")) {
+		obs_source_set_enabled(source, obs_data_get_bool(data, "enabled"));
+		changed = true;
+	}
+	if (obs_data_has_user_value(data, "muted") && obs_source_muted(source) != obs_data_get_bool(data, "muted")) {
+		obs_source_set_muted(source, obs_data_get_bool(data, "muted"));
+		changed = true;
+	}
+	const float volume = (float)obs_data_get_double(data, "volume");
+	if (obs_data_has_user_value(data, "volume") && obs_source_get_volume(source) != volume) {
+		obs_source_set_volume(source, volume);
+		changed = true;
+	}
+	return changed;
+}
+
+static bool PatchFilters(obs_source_t *source, obs_data_t *data)
+{
+	obs_data_array_t *filters = obs_data_get_array(data, "filters");
+	if (!filters)
+		return false;
+	bool changed = false;
+	std::unordered_set<std::string> names;
+	const size_t count = obs_data_array_count(filters);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *filterData = obs_data_array_item(filters, i);
+		const char *name = obs_data_get_string(filterData, "name");
+		names.emplace(name);
+		obs_source_t *filter = obs_source_get_filter_by_name(source, name);
+		if (filter && strcmp(obs_source_get_id(filter), obs_data_get_string(filterData, "id")) != 0) {
+			obs_source_filter_remove(source, filter);
+			obs_source_release(filter);
+			filter = nullptr;
+		}
+		if (filter) {
+			changed |= PatchSettings(filter, filterData);
+		} else {
+			filter = obs_load_source(filterData);
+			if (filter) {
+				obs_source_filter_add(source, filter);
+				obs_source_load(filter);
+			}
+			changed = true;
+		}
+		if (filter && obs_source_filter_get_index(source, filter) != (int)i) {
+			obs_source_filter_set_index(source, filter, i);
+			changed = true;
+		}
+		obs_source_release(filter);
+		obs_data_release(filterData);
+	}
+	obs_data_array_release(filters);
+
+	typedef std::pair<std::unordered_set<std::string> *, std::vector<obs_source_t *>> StaleFilters;
+	StaleFilters stale{&names, {}};
+	obs_source_enum_filters(
+		source,
+		[](obs_source_t *, obs_source_t *filter, void *param) {
+			auto stale = static_cast<StaleFilters *>(param);
+			if (!stale->first->count(obs_source_get_name(filter)))
+				stale->second.push_back(obs_source_get_ref(filter));
+		},
+		&stale);
+	for (obs_source_t *filter : stale.second) {
+		obs_source_filter_remove(source, filter);
+		obs_source_release(filter);
+		changed = true;
+	}
+	return changed;
+}
+
+static bool CollectSceneItem(obs_scene_t *scene, obs_sceneitem_t *item, void *param)
+{
+	UNUSED_PARAMETER(scene);
+	static_cast<std::vector<obs_sceneitem_t *> *>(param)->push_back(item);
+	return true;
+}
+
+static bool CountSceneItem(obs_scene_t *, obs_sceneitem_t *, void *param)
+{
+	(*static_cast<size_t *>(param))++;
+	return true;
+}
+
+static bool PatchSceneItem(obs_sceneitem_t *item, obs_data_t *data)
+{
+	obs_transform_info current{};
+	obs_sceneitem_get_info2(item, &current);
+	obs_transform_info info = current;
+	info.rot = (float)obs_data_get_double(data, "rot");
+	obs_data_get_vec2(data, "pos", &info.pos);
+	obs_data_get_vec2(data, "scale", &info.scale);
+	info.alignment = (uint32_t)obs_data_get_int(data, "align");
+	info.bounds_type = (enum obs_bounds_type)obs_data_get_int(data, "bounds_type");
+	info.bounds_alignment = (uint32_t)obs_data_get_int(data, "bounds_align");
+	info.crop_to_bounds = obs_data_get_bool(data, "bounds_crop");
+	obs_data_get_vec2(data, "bounds", &info.bounds);
+	obs_sceneitem_crop crop{};
+	obs_sceneitem_get_crop(item, &crop);
+	obs_sceneitem_crop newCrop{};
+	newCrop.left = (int)obs_data_get_int(data, "crop_left");
+	newCrop.top = (int)obs_data_get_int(data, "crop_top");
+	newCrop.right = (int)obs_data_get_int(data, "crop_right");
+	newCrop.bottom = (int)obs_data_get_int(data, "crop_bottom");
+
+	bool changed = false;
+	if (memcmp(&info, &current, sizeof(info)) != 0) {
+		obs_sceneitem_set_info2(item, &info);
+		changed = true;
+	}
+	if (memcmp(&crop, &newCrop, sizeof(crop)) != 0) {
+		obs_sceneitem_set_crop(item, &newCrop);
+		changed = true;
+	}
+	if (obs_sceneitem_visible(item) != obs_data_get_bool(data, "visible")) {
+		obs_sceneitem_set_visible(item, obs_data_get_bool(data, "visible"));
+		changed = true;
+	}
+	if (obs_sceneitem_locked(item) != obs_data_get_bool(data, "locked")) {
+		obs_sceneitem_set_locked(item, obs_data_get_bool(data, "locked"));
+		changed = true;
+	}
+	return changed;
+}
+
+// Update the items of a scene in place when the patch refers to exactly the items it already has,
+// returns false when the scene has to be reloaded from its settings instead.
+static bool PatchSceneItems(obs_scene_t *scene, obs_data_t *settings, bool &changed)
+{
+	obs_data_array_t *items = obs_data_get_array(settings, "items");
+	if (!items)
+		return false;
+	const size_t count = obs_data_array_count(items);
+	size_t existing = 0;
+	obs_scene_enum_items(scene, CountSceneItem, &existing);
+	if (existing != count) {
+		obs_data_array_release(items);
+		return false;
+	}
+	std::vector<obs_sceneitem_t *> targets;
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *itemData = obs_data_array_item(items, i);
+		obs_sceneitem_t *item = obs_scene_find_sceneitem_by_id(scene, obs_data_get_int(itemData, "id"));
+		if (item && strcmp(obs_source_get_name(obs_sceneitem_get_source(item)), obs_data_get_string(itemData, "name")) == 0)
+			targets.push_back(item);
+		obs_data_release(itemData);
+	}
+	if (targets.size() != count) {
+		obs_data_array_release(items);
+		return false;
+	}
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *itemData = obs_data_array_item(items, i);
+		obs_sceneitem_defer_update_begin(targets[i]);
+		changed |= PatchSceneItem(targets[i], itemData);
+		obs_sceneitem_defer_update_end(targets[i]);
+		obs_data_release(itemData);
+	}
+	for (size_t i = 0; i < count; i++)
+		obs_sceneitem_set_order_position(targets[i], (int)i);
+	obs_data_array_release(items);
+	return true;
+}
+
+static bool PatchSource(obs_source_t *source, obs_data_t *data)
+{
+	bool changed = false;
+	obs_scene_t *scene = obs_scene_from_source(source);
+	if (!scene)
+		scene = obs_group_from_source(source);
+	if (scene) {
+		obs_data_t *settings = obs_data_get_obj(data, "settings");
+		if (settings && !PatchSceneItems(scene, settings, changed)) {
+			obs_source_update(source, settings);
+			obs_source_load(source);
+			changed = true;
+		}
+		obs_data_release(settings);
+	} else {
+		changed |= PatchSettings(source, data);
+	}
+	changed |= PatchFilters(source, data);
+	return changed;
+}
+
+class SourceSnapshot {
+	std::unordered_map<std::string, obs_source_t *> sources;
+
+	static std::string Key(const char *name, obs_canvas_t *canvas)
+	{
+		std::string key = canvas ? obs_canvas_get_uuid(canvas) : "";
+		key += '\n';
+		key += name;
+		return key;
+	}
+
+public:
+	~SourceSnapshot()
+	{
+		for (auto &it : sources)
+			obs_source_release(it.second);
+	}
+
+	obs_source_t *Find(const char *name, obs_canvas_t *canvas)
+	{
+		const std::string key = Key(name, canvas);
+		auto it = sources.find(key);
+		if (it != sources.end())
+			return it->second;
+		obs_source_t *source = canvas ? obs_canvas_get_source_by_name(canvas, name) : obs_get_source_by_name(name);
+		sources.emplace(key, source);
+		return source;
+	}
+
+	void Add(obs_source_t *source, obs_canvas_t *canvas)
+	{
+		auto &s = sources[Key(obs_source_get_name(source), canvas)];
+		obs_source_release(s);
+		s = obs_source_get_ref(source);
+	}
+
+	// Drops cached misses, for after sources were created behind the snapshot's back.
+	void ForgetMissing()
+	{
+		for (auto it = sources.begin(); it != sources.end();) {
+			if (it->second)
+				++it;
+			else
+				it = sources.erase(it);
+		}
+	}
+};
+
+struct ImportResult {
+	std::vector<std::pair<std::string, std::string>> created;
+	std::vector<std::string> skipped;
+	std::vector<std::string> changed;
+	std::vector<std::string> errors;
+};
+
+// Parent of the imports and pastes that continue on later event loop turns. Deleting it cancels them, so none of
+// them runs after exit.
+static QObject *deferred_context = nullptr;
+
+static QObject *DeferredContext()
+{
+	if (!deferred_context)
+		deferred_context = new QObject();
+	return deferred_context;
+}
+
+static void CancelDeferred()
+{
+	delete deferred_context;
+	deferred_context = nullptr;
+}
+
+// Links the uuids of mirrored sources to the local ones. A source created from the leader's data keeps the leader's
+// uuid, a local source adopted by name keeps its own, as the uuid of a source cannot be changed. UI thread only.
+class MirrorUuids {
+	std::unordered_map<std::string, std::string> local;
+	std::unordered_map<std::string, std::string> leader;
+
+	static obs_source_t *GetByName(const char *name, obs_canvas_t *canvas)
+	{
+		return canvas ? obs_canvas_get_source_by_name(canvas, name) : obs_get_source_by_name(name);
+	}
+
+public:
+	void Link(const std::string &leader_uuid, const std::string &local_uuid)
+	{
+		Unlink(leader_uuid);
+		auto back = leader.find(local_uuid);
+		if (back != leader.end()) {
+			local.erase(back->second);
+			leader.erase(back);
+		}
+		local[leader_uuid] = local_uuid;
+		leader[local_uuid] = leader_uuid;
+	}
+
+	void Unlink(const std::string &leader_uuid)
+	{
+		auto it = local.find(leader_uuid);
+		if (it == local.end())
+			return;
+		leader.erase(it->second);
+		local.erase(it);
+	}
+
+	// The local source of a leader uuid, only on an exact match through a link or the uuid itself.
+	obs_source_t *Find(const std::string &leader_uuid) const
+	{
+		auto it = local.find(leader_uuid);
+		return obs_get_source_by_uuid(it != local.end() ? it->second.c_str() : leader_uuid.c_str());
+	}
+
+	// Like Find, but without an exact match a local source of the same name is adopted when no other leader source is
+	// linked to it. The match is linked and renamed to the leader's name when that name is free.
+	obs_source_t *Match(const std::string &leader_uuid, const char *name, obs_canvas_t *canvas)
+	{
+		if (leader_uuid.empty())
+			return nullptr;
+		obs_source_t *source = Find(leader_uuid);
+		if (!source) {
+			source = GetByName(name, canvas);
+			if (source && leader.count(obs_source_get_uuid(source))) {
+				obs_source_release(source);
+				return nullptr;
+			}
+		}
+		if (!source)
+			return nullptr;
+		Link(leader_uuid, obs_source_get_uuid(source));
+		if (strcmp(obs_source_get_name(source), name) != 0) {
+			obs_source_t *other = GetByName(name, canvas);
+			if (!other)
+				obs_source_set_name(source, name);
+			obs_source_release(other);
+		}
+		return source;
+	}
+
+	// Removes the linked sources whose leader uuid is not in present, for after a full snapshot: events that were lost
+	// before it may have held removals. Returns the leader uuid and local name of each removed source.
+	std::vector<std::pair<std::string, std::string>> RemoveMissing(const std::unordered_set<std::string> &present)
+	{
+		std::vector<std::string> missing;
+		for (const auto &it : local) {
+			if (!present.count(it.first))
+				missing.push_back(it.first);
+		}
+		std::vector<std::pair<std::string, std::string>> removed;
+		for (const auto &uuid : missing) {
+			obs_source_t *source = Find(uuid);
+			Unlink(uuid);
+			if (!source)
+				continue;
+			removed.emplace_back(uuid, obs_source_get_name(source));
+			obs_source_remove(source);
+			obs_source_release(source);
+		}
+		return removed;
+	}
+
+	// Points the items of a mirrored scene at the local sources linked to the leader's.
+	void MapItems(obs_data_t *data) const
+	{
+		obs_data_t *settings = obs_data_get_obj(data, "settings");
+		obs_data_array_t *items = settings ? obs_data_get_array(settings, "items") : nullptr;
+		const size_t count = obs_data_array_count(items);
+		for (size_t i = 0; i < count; i++) {
+			obs_data_t *item = obs_data_array_item(items, i);
+			auto it = local.find(obs_data_get_string(item, "source_uuid"));
+			if (it != local.end())
+				obs_data_set_string(item, "source_uuid", it->second.c_str());
+			obs_data_release(item);
+		}
+		obs_data_array_release(items);
+		obs_data_release(settings);
+	}
+};
+
+class SourceImport : public QObject {
+public:
+	typedef std::function<void(size_t done, size_t total)> progress_cb;
+	typedef std::function<void(const ImportResult &result)> complete_cb;
+	// Appends the next part of a streamed payload, sets how far it got and returns false once it is exhausted.
+	typedef std::function<bool(size_t &done, size_t &total)> feed_cb;
+
+	// With uuids, existing sources are matched through the mirror links instead of by name.
+	SourceImport(obs_data_array_t *data, obs_scene_t *scene, obs_canvas_t *canvas, MirrorUuids *uuids = nullptr);
+	SourceImport(obs_scene_t *scene, obs_canvas_t *canvas);
+	// Imports sources of several canvases, placing each by its saved canvas_uuid through the given map.
+	SourceImport(obs_data_array_t *data, const std::unordered_map<std::string, obs_canvas_t *> &canvases,
+		     MirrorUuids *uuids = nullptr);
+	~SourceImport();
+
+	// Plans and creates one more source right away, takes ownership of data.
+	void Append(obs_data_t *data);
+	void Run();
+	// Imports a batch per event loop turn and deletes itself when done, or earlier when CancelDeferred runs.
+	void Start(progress_cb progress, complete_cb complete);
+
+	void SetUpdateExisting(bool update) { update_existing = update; }
+	// Runs feed once per batch until it is exhausted, sources are loaded and added to the scene only after that.
+	void SetFeed(feed_cb feed_) { feed = std::move(feed_); }
+	const ImportResult &Result() const { return result; }
+
+private:
+	struct Entry {
+		obs_data_t *data = nullptr;
+		std::string saved_uuid;
+		obs_canvas_t *canvas = nullptr;
+		obs_source_t *existing = nullptr;
+		size_t duplicate_of = SIZE_MAX;
+		bool skip_load = false;
+		obs_source_t *source = nullptr;
+	};
+
+	std::vector<Entry> entries;
+	obs_source_t *scene_source = nullptr;
+	obs_canvas_t *canvas = nullptr;
+	std::unordered_map<std::string, obs_canvas_t *> canvas_map;
+	MirrorUuids *uuids = nullptr;
+	SourceSnapshot snapshot;
+	ImportResult result;
+	std::unordered_map<std::string, size_t> planned;
+	// Content hash per existing source, a source named more than once in the payload is only saved once.
+	std::unordered_map<obs_source_t *, std::string> existing_hashes;
+	bool update_existing = false;
+	bool added = false;
+	size_t created = 0;
+	size_t loaded = 0;
+	progress_cb progress;
+	complete_cb complete;
+	feed_cb feed;
+
+	void Plan(obs_data_t *data);
+	void Create(size_t i);
+	bool Step();
+	void Schedule();
+};
+
+SourceImport::SourceImport(obs_data_array_t *data, obs_scene_t *scene, obs_canvas_t *canvas_, MirrorUuids *uuids_)
+	: SourceImport(scene, canvas_)
+{
+	uuids = uuids_;
+	const size_t count = obs_data_array_count(data);
+	entries.reserve(count);
+	for (size_t i = 0; i < count; i++)
+		Plan(obs_data_array_item(data, i));
+}
+
+SourceImport::SourceImport(obs_scene_t *scene, obs_canvas_t *canvas_)
+	: scene_source(scene ? obs_source_get_ref(obs_scene_get_source(scene)) : nullptr),
+	  canvas(canvas_ ? obs_canvas_get_ref(canvas_) : nullptr)
+{
+}
+
+SourceImport::SourceImport(obs_data_array_t *data, const std::unordered_map<std::string, obs_canvas_t *> &canvases,
+			   MirrorUuids *uuids_)
+	: uuids(uuids_)
+{
+	for (const auto &it : canvases)
+		canvas_map.emplace(it.first, obs_canvas_get_ref(it.second));
+	const size_t count = obs_data_array_count(data);
+	entries.reserve(count);
+	for (size_t i = 0; i < count; i++)
+		Plan(obs_data_array_item(data, i));
+}
+
+SourceImport::~SourceImport()
+{
+	for (auto &entry : entries) {
+		obs_source_release(entry.source);
+		obs_data_release(entry.data);
+	}
+	for (auto &it : canvas_map)
+		obs_canvas_release(it.second);
+	obs_source_release(scene_source);
+	obs_canvas_release(canvas);
+}
+
+void SourceImport::Plan(obs_data_t *sourceData)
+{
+	const size_t i = entries.size();
+	entries.emplace_back();
+	Entry &entry = entries.back();
+	entry.data = sourceData;
+	entry.saved_uuid = obs_data_get_string(sourceData, "uuid");
+	const char *name = obs_data_get_string(sourceData, "name");
+	const char *canvas_uuid = obs_data_get_string(sourceData, "canvas_uuid");
+	obs_canvas_t *target = canvas;
+	if (!canvas_map.empty() && canvas_uuid) {
+		auto it = canvas_map.find(canvas_uuid);
+		if (it != canvas_map.end())
+			target = it->second;
+	}
+	if (target && canvas_uuid && canvas_uuid[0] != '\0' && strcmp(canvas_uuid, obs_canvas_get_uuid(target)) != 0) {
+		obs_data_set_string(sourceData, "canvas_uuid", obs_canvas_get_uuid(target));
+		obs_source_t *found = obs_get_source_by_uuid(obs_data_get_string(sourceData, "uuid"));
+		if (found) {
+			obs_canvas_t *found_canvas = obs_source_get_canvas(found);
+			if (found_canvas != target) {
+				obs_data_unset_user_value(sourceData, "uuid");
+			}
+			obs_canvas_release(found_canvas);
+			obs_source_release(found);
+		}
+	}
+	if (target && obs_get_source_output_flags(obs_data_get_string(sourceData, "id")) & OBS_SOURCE_REQUIRES_CANVAS)
+		entry.canvas = target;
+	if (uuids) {
+		uuids->MapItems(sourceData);
+		if (obs_source_t *found = uuids->Match(entry.saved_uuid, name, entry.canvas)) {
+			snapshot.Add(found, entry.canvas);
+			entry.existing = found;
+			obs_source_release(found);
+		}
+	} else {
+		entry.existing = snapshot.Find(name, entry.canvas);
+	}
+	if (entry.existing) {
+		auto hash = existing_hashes.find(entry.existing);
+		if (hash == existing_hashes.end())
+			hash = existing_hashes.emplace(entry.existing, GetContentHash(entry.existing)).first;
+		if (hash->second == ContentHash(sourceData)) {
+			entry.skip_load = true;
+			result.skipped.emplace_back(name);
+		} else {
+			result.changed.emplace_back(name);
+		}
+		return;
+	}
+	std::string key = entry.canvas ? obs_canvas_get_uuid(entry.canvas) : "";
+	key += '\n';
+	key += name;
+	auto it = planned.find(key);
+	if (it != planned.end()) {
+		entry.duplicate_of = it->second;
+		entry.skip_load = true;
+	} else {
+		planned.emplace(key, i);
+	}
+}
+
+void SourceImport::Create(size_t i)
+{
+	Entry &entry = entries[i];
+	obs_data_t *sourceData = entry.data;
+	obs_source_t *s = nullptr;
+	if (entry.existing) {
+		s = obs_source_get_ref(entry.existing);
+		if (!entry.skip_load && update_existing) {
+			PatchSource(s, sourceData);
+			existing_hashes.erase(s);
+		}
+		// An existing source is patched or kept as it is, never updated or loaded again from the payload.
+		entry.skip_load = true;
+	} else if (entry.duplicate_of != SIZE_MAX) {
+		s = obs_source_get_ref(entries[entry.duplicate_of].source);
+	} else {
+		s = obs_load_source(sourceData);
+		if (s) {
+			if (uuids && !entry.saved_uuid.empty())
+				uuids->Link(entry.saved_uuid, obs_source_get_uuid(s));
+			snapshot.Add(s, entry.canvas);
+			result.created.emplace_back(obs_source_get_name(s), obs_source_get_uuid(s));
+		} else {
+			result.errors.push_back(std::string("failed to create source ") + obs_data_get_string(sourceData, "name"));
+		}
+	}
+	entry.source = s;
+	obs_scene_t *nested_scene = obs_scene_from_source(s);
+	if (!nested_scene)
+		nested_scene = obs_group_from_source(s);
+	if (nested_scene && !entry.skip_load) {
+		obs_data_t *scene_settings = obs_data_get_obj(sourceData, "settings");
+		obs_source_update(s, scene_settings);
+		obs_data_release(scene_settings);
+	}
+	// Only the created source is needed from here on, do not keep every payload around until the import ends.
+	obs_data_release(entry.data);
+	entry.data = nullptr;
+}
+
+void SourceImport::Append(obs_data_t *data)
+{
+	Plan(data);
+	Create(created++);
+}
+
+bool SourceImport::Step()
+{
+	if (feed) {
+		size_t done = 0, total = 1;
+		const bool more = feed(done, total);
+		if (more) {
+			// Feeding takes the first half of the progress, creating and loading the second.
+			if (progress)
+				progress(done, total * 2);
+			return false;
+		}
+		feed = nullptr;
+	}
+	size_t budget = IMPORT_BATCH_SIZE;
+	while (budget && created < entries.size()) {
+		Create(created++);
+		budget--;
+	}
+	if (created == entries.size() && !added) {
+		added = true;
+		obs_scene_t *scene = obs_scene_from_source(scene_source);
+		obs_source_t *s = entries.empty() ? nullptr : entries.back().source;
+		if (scene && s &&
+		    (obs_source_get_type(s) == OBS_SOURCE_TYPE_SCENE || obs_source_get_type(s) == OBS_SOURCE_TYPE_INPUT))
+			obs_scene_add(scene, s);
+	}
+	while (budget && created == entries.size() && loaded < entries.size()) {
+		if (entries[loaded].source && !entries[loaded].skip_load)
+			obs_source_load(entries[loaded].source);
+		loaded++;
+		budget--;
+	}
+	if (progress)
+		progress(created + loaded, entries.size() * 2);
+	return loaded == entries.size();
+}
+
+void SourceImport::Run()
+{
+	while (!Step())
+		;
+}
+
+void SourceImport::Schedule()
+{
+	QTimer::singleShot(0, this, [this] {
+		if (!Step()) {
+			Schedule();
+			return;
+		}
+		if (complete)
+			complete(result);
+		deleteLater();
+	});
+}
+
+void SourceImport::Start(progress_cb progress_, complete_cb complete_)
+{
+	progress = std::move(progress_);
+	complete = std::move(complete_);
+	setParent(DeferredContext());
+	Schedule();
+}
+
+static void StartInteractiveImport(SourceImport *import, bool update_existing);
+
+static void LogImportResult(const ImportResult &result, bool update_existing)
+{
+	for (const auto &error : result.errors)
+		blog(LOG_WARNING, "[Source Copy] %s", error.c_str());
+	if (update_existing)
+		return;
+	for (const auto &name : result.changed)
+		blog(LOG_INFO, "[Source Copy] Kept existing source '%s' with different settings", name.c_str());
+}
+
+static void LoadSources(obs_data_array_t *data, obs_scene_t *scene, obs_canvas_t *canvas = nullptr, bool interactive = false,
+			bool update_existing = false)
+{
+	if (!interactive) {
+		SourceImport import(data, scene, canvas);
+		import.SetUpdateExisting(update_existing);
+		import.Run();
+		LogImportResult(import.Result(), update_existing);
+		return;
+	}
+	auto import = new SourceImport(data, scene, canvas);
+	import->SetUpdateExisting(update_existing);
+	StartInteractiveImport(import, update_existing);
+}
+
+static void StartInteractiveImport(SourceImport *import, bool update_existing)
+{
+	const auto main_window = static_cast<QMainWindow *>(obs_frontend_get_main_window());
+	auto dialog = new QProgressDialog(QT_UTF8(obs_module_text("Importing")), QString(), 0, 1, main_window);
+	dialog->setWindowModality(Qt::WindowModal);
+	dialog->setMinimumDuration(500);
+	dialog->setAutoClose(false);
+	dialog->setAutoReset(false);
+	QPointer<QProgressDialog> progress = dialog;
+	import->Start(
+		[progress](size_t done, size_t total) {
+			if (!progress)
+				return;
+			progress->setMaximum((int)total);
+			progress->setValue((int)done);
+		},
+		[progress, update_existing](const ImportResult &result) {
+			LogImportResult(result, update_existing);
+			if (progress)
+				progress->deleteLater();
+		});
+}
+
+static void LoadSceneCanvas(obs_data_t *data, obs_canvas_t *canvas, bool interactive = false)
+{
+	if (!data)
+		return;
+	obs_data_array_t *sourcesData = obs_data_get_array(data, "sources");
+	if (!sourcesData)
+		return;
+	LoadSources(sourcesData, nullptr, canvas, interactive, obs_data_get_bool(data, "update_existing"));
+	obs_data_array_release(sourcesData);
+}
+
+// A json file mapped and scanned a chunk at a time, every entry of its "sources" array is appended to the import as
+// soon as it is parsed.
+struct SourceStream {
+	QString fileName;
+	QFile file;
+	qint64 size = 0;
+	qint64 offset = 0;
+	uchar *map = nullptr;
+	QByteArray buffer;
+	JsonScanner scanner{{"sources"}, true};
+	std::vector<std::string> prefixes;
+	std::shared_ptr<PathIndex> index;
+	SourceImport *import = nullptr;
+	uint64_t start = 0;
+	uint64_t first = 0;
+
+	SourceStream(const QString &fileName_) : fileName(fileName_), file(fileName_) {}
+	~SourceStream()
+	{
+		if (map)
+			file.unmap(map);
+	}
+
+	// Scans the next chunk, returns false at the end of the file or of the "sources" array.
+	bool Feed()
+	{
+		const qint64 length = std::min((qint64)STREAM_CHUNK_SIZE, size - offset);
+		const char *chunk = reinterpret_cast<const char *>(map) + offset;
+		if (!map) {
+			buffer = file.read(length);
+			if (buffer.size() != length)
+				return false;
+			chunk = buffer.constData();
+		}
+		offset += length;
+		const bool more = scanner.Feed(chunk, (size_t)length, [this](std::string &json) {
+			obs_data_t *data = obs_data_create_from_json(json.c_str());
+			if (!data)
+				return;
+			try_fix_paths(data, *index, prefixes);
+			import->Append(data);
+			if (!first)
+				first = os_gettime_ns();
+		});
+		if (more && offset < size)
+			return true;
+		if (first)
+			blog(LOG_INFO, "[Source Copy] Streamed '%s' (%lld bytes): first source after %.1f ms, last after %.1f ms",
+			     QT_TO_UTF8(fileName), (long long)size, (double)(first - start) / 1000000.0,
+			     (double)(os_gettime_ns() - start) / 1000000.0);
 		return false;
-	str.replace(start_pos, strlen(from), to);
+	}
+};
+
+// Creates the sources of a json file one "sources" entry at a time while scanning the mapped file, so only a single
+// source is parsed at any moment. The file is scanned up to the first source right away, the rest a chunk per import
+// batch. Returns false when the file has no "sources" array and has to be loaded whole.
+static bool StreamSourcesFile(const QString &fileName, obs_scene_t *scene, obs_canvas_t *canvas)
+{
+	if (fileName.endsWith(BUNDLE_EXTENSION, Qt::CaseInsensitive))
+		return false;
+	auto stream = std::make_shared<SourceStream>(fileName);
+	if (!stream->file.open(QIODevice::ReadOnly))
+		return false;
+	stream->start = os_gettime_ns();
+	stream->size = stream->file.size();
+	stream->map = stream->file.map(0, stream->size);
+	stream->index = BeginPathLoad(fileName, stream->prefixes);
+	auto import = new SourceImport(scene, canvas);
+	stream->import = import;
+	bool more = true;
+	while (more && !stream->first)
+		more = stream->Feed();
+	if (!stream->first) {
+		delete import;
+		return false;
+	}
+	if (more) {
+		import->SetFeed([stream](size_t &done, size_t &total) {
+			const bool next = stream->Feed();
+			done = (size_t)(stream->offset / STREAM_CHUNK_SIZE);
+			total = (size_t)(stream->size / STREAM_CHUNK_SIZE) + 1;
+			return next;
+		});
+	}
+	StartInteractiveImport(import, false);
 	return true;
 }
 
-static void try_fix_paths(obs_data_t *data, const char *dir, char *path_buffer)
+// Matches every saved canvas to an existing one by uuid, then by name, and falls back to the main canvas.
+// Maps the saved canvas uuids to local canvases, by uuid and then by name, falling back to the main canvas. Every
+// canvas in the map holds a reference.
+static std::unordered_map<std::string, obs_canvas_t *> GetCanvasMap(obs_data_array_t *canvases)
 {
-	obs_data_item_t *item = obs_data_first(data);
-	while (item) {
-		const enum obs_data_type type = obs_data_item_gettype(item);
-		if (type == OBS_DATA_STRING) {
-			std::string str = obs_data_item_get_string(item);
-			bool edit = false;
-			if (replace(str, "[U_COMBOBULATOR_PATH]", dir)) {
-				obs_data_item_set_string(&item, str.c_str());
-				edit = true;
-			}
-			bool local_url = false;
-			if (str.substr(0, 7) == "file://") {
-				str = str.substr(7);
-				local_url = true;
-			}
-			std::size_t found = str.find_last_of("/\\");
-			if (str.length() < MAX_PATH && found != std::string::npos && !os_file_exists(str.c_str())) {
-				while (found != std::string::npos) {
-					auto file = found == 0 && str[0] != '/' && str[0] != '\\' ? str : str.substr(found + 1);
-					if (file.find('.') == std::string::npos)
-						break;
-					auto oldDir = str.substr(0, found + 1);
-					std::string newFile = dir;
-					newFile += file;
-					if (os_file_exists(newFile.c_str())) {
-						if (local_url) {
-							str = "file://";
-							if (os_get_abs_path(newFile.c_str(), path_buffer, MAX_PATH)) {
-								for (auto i = 0; path_buffer[i] != '\0'; i++)
-									if (path_buffer[i] == '\\')
-										path_buffer[i] = '/';
-								str += path_buffer;
-							}
-						} else {
-							if (os_get_abs_path(newFile.c_str(), path_buffer, MAX_PATH)) {
-								for (auto i = 0; path_buffer[i] != '\0'; i++)
-									if (path_buffer[i] == '\\')
-										path_buffer[i] = '/';
-								str = path_buffer;
-							} else {
-								str = "";
-							}
-						}
-						obs_data_item_set_string(&item, str.c_str());
-						edit = true;
-						break;
-					}
-					if (found == 0) {
-						found = std::string::npos;
-					} else {
-						found = str.find_last_of("/\\", found - 1);
-						if (found == std::string::npos) {
-							found = 0;
-						}
-					}
-				}
-			}
-			if (edit) {
-				item = obs_data_first(data);
-				continue;
-			}
-		} else if (type == OBS_DATA_OBJECT) {
-			if (obs_data_t *obj = obs_data_item_get_obj(item)) {
-				try_fix_paths(obj, dir, path_buffer);
-				obs_data_release(obj);
-			}
-		} else if (type == OBS_DATA_ARRAY) {
-			const auto array = obs_data_item_get_array(item);
-			const auto count = obs_data_array_count(array);
-			for (size_t i = 0; i < count; i++) {
-				if (obs_data_t *obj = obs_data_array_item(array, i)) {
-					try_fix_paths(obj, dir, path_buffer);
-					obs_data_release(obj);
-				}
-			}
+	std::unordered_map<std::string, obs_canvas_t *> map;
+	const size_t count = obs_data_array_count(canvases);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *canvasData = obs_data_array_item(canvases, i);
+		const char *uuid = obs_data_get_string(canvasData, "uuid");
+		const char *name = obs_data_get_string(canvasData, "name");
+		obs_canvas_t *canvas = obs_get_canvas_by_uuid(uuid);
+		if (!canvas)
+			canvas = obs_get_canvas_by_name(name);
+		if (!canvas) {
+			blog(LOG_WARNING, "[Source Copy] Canvas '%s' not found, importing its scenes into the main canvas", name);
+			canvas = obs_get_main_canvas();
 		}
-		obs_data_item_next(&item);
+		obs_canvas_release(map[uuid]);
+		map[uuid] = canvas;
+		obs_data_release(canvasData);
 	}
+	return map;
 }
 
-static void try_fix_paths(obs_data_t *data, QString fileName)
+static SourceImport *CreateCanvasesImport(obs_data_t *data, MirrorUuids *uuids = nullptr)
 {
-	char path_buffer[MAX_PATH];
-	std::string dir = QT_TO_UTF8(fileName);
-	const std::size_t slash = dir.find_last_of("/\\");
-	if (slash != std::string::npos) {
-		auto point = dir.find_last_of('.');
-		if (point != std::string::npos && point > slash) {
-			dir = dir.substr(0, point);
-			dir += "/";
-			try_fix_paths(data, dir.c_str(), path_buffer);
+	obs_data_array_t *canvases = obs_data_get_array(data, "canvases");
+	obs_data_array_t *sources = obs_data_get_array(data, "sources");
+	if (!canvases || !sources) {
+		obs_data_array_release(canvases);
+		obs_data_array_release(sources);
+		return nullptr;
+	}
+	auto map = GetCanvasMap(canvases);
+	auto import = new SourceImport(sources, map, uuids);
+	for (auto &it : map)
+		obs_canvas_release(it.second);
+	obs_data_array_release(canvases);
+	obs_data_array_release(sources);
+	return import;
+}
+
+static void LoadCanvases(obs_data_t *data)
+{
+	if (!data)
+		return;
+	if (SourceImport *import = CreateCanvasesImport(data))
+		StartInteractiveImport(import, false);
+}
+
+typedef std::map<std::string, std::string> TemplateParameters;
+
+// A scene whose strings may contain ${placeholder}s. The json text is split into literal and placeholder segments
+// once, so every copy is stamped out by concatenation instead of walking the settings again.
+class SceneTemplate {
+	std::vector<std::string> literals;
+	std::vector<std::string> placeholders;
+
+	static void AppendEscaped(std::string &json, const std::string &value)
+	{
+		for (const char c : value) {
+			if (c == '"' || c == '\\') {
+				json += '\\';
+				json += c;
+			} else if ((unsigned char)c < 0x20) {
+				char escaped[8];
+				snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+				json += escaped;
+			} else {
+				json += c;
+			}
 		}
-		dir = dir.substr(0, slash + 1);
 	}
-	try_fix_paths(data, dir.c_str(), path_buffer);
+
+public:
+	explicit SceneTemplate(obs_data_t *data)
+	{
+		obs_data_array_t *sources = obs_data_get_array(data, "sources");
+		obs_data_t *wrapper = obs_data_create();
+		obs_data_set_array(wrapper, "sources", sources);
+		obs_data_array_release(sources);
+		const std::string json = obs_data_get_json(wrapper);
+		obs_data_release(wrapper);
+
+		size_t pos = 0;
+		literals.emplace_back();
+		while (pos < json.size()) {
+			const size_t start = json.find("${", pos);
+			const size_t end = start == std::string::npos ? std::string::npos : json.find('}', start + 2);
+			if (end == std::string::npos) {
+				literals.back() += json.substr(pos);
+				break;
+			}
+			literals.back() += json.substr(pos, start - pos);
+			placeholders.push_back(json.substr(start + 2, end - start - 2));
+			literals.emplace_back();
+			pos = end + 1;
+		}
+	}
+
+	const std::vector<std::string> &Placeholders() const { return placeholders; }
+
+	// The template's sources with every known placeholder replaced, unknown ones are left as they are.
+	obs_data_array_t *Instantiate(const TemplateParameters &parameters) const
+	{
+		std::string json = literals.front();
+		for (size_t i = 0; i < placeholders.size(); i++) {
+			auto it = parameters.find(placeholders[i]);
+			if (it != parameters.end())
+				AppendEscaped(json, it->second);
+			else
+				json += "${" + placeholders[i] + "}";
+			json += literals[i + 1];
+		}
+		obs_data_t *data = obs_data_create_from_json(json.c_str());
+		obs_data_array_t *sources = data ? obs_data_get_array(data, "sources") : nullptr;
+		obs_data_release(data);
+		return sources;
+	}
+};
+
+static std::string UniqueSourceName(const std::string &name, obs_canvas_t *canvas, std::unordered_set<std::string> &used)
+{
+	std::string unique = name;
+	for (int i = 2;; i++) {
+		obs_source_t *existing = obs_get_source_by_name(unique.c_str());
+		if (!existing && canvas)
+			existing = obs_canvas_get_source_by_name(canvas, unique.c_str());
+		obs_source_release(existing);
+		if (!existing && used.emplace(unique).second)
+			return unique;
+		unique = name + " " + std::to_string(i);
+	}
 }
 
-static void LoadSourceMenu(QMenu *menu, obs_source_t *source, obs_sceneitem_t *item);
+// Points the items of a saved scene or group at the sources of the same copy by name. The template's source uuids are
+// dropped from every item, as they belong to the template's sources and not to this copy.
+static void RenameSceneItems(obs_data_t *sourceData, const std::unordered_map<std::string, std::string> &renamed)
+{
+	obs_data_t *settings = obs_data_get_obj(sourceData, "settings");
+	obs_data_array_t *items = settings ? obs_data_get_array(settings, "items") : nullptr;
+	const size_t count = obs_data_array_count(items);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *item = obs_data_array_item(items, i);
+		obs_data_unset_user_value(item, "source_uuid");
+		auto it = renamed.find(obs_data_get_string(item, "name"));
+		if (it != renamed.end())
+			obs_data_set_string(item, "name", it->second.c_str());
+		obs_data_release(item);
+	}
+	obs_data_array_release(items);
+	obs_data_release(settings);
+}
 
-static void LoadSources(obs_data_array_t *data, obs_scene_t *scene, obs_canvas_t *canvas = nullptr)
+static void UnsetFilterUuids(obs_data_t *sourceData)
 {
-	const size_t count = obs_data_array_count(data);
-	std::vector<obs_source_t *> sources;
-	sources.reserve(count);
+	obs_data_array_t *filters = obs_data_get_array(sourceData, "filters");
+	const size_t count = obs_data_array_count(filters);
 	for (size_t i = 0; i < count; i++) {
-		obs_data_t *sourceData = obs_data_array_item(data, i);
-		const char *name = obs_data_get_string(sourceData, "name");
-		const char *canvas_uuid = obs_data_get_string(sourceData, "canvas_uuid");
-		if (canvas && canvas_uuid && canvas_uuid[0] != '\0' && strcmp(canvas_uuid, obs_canvas_get_uuid(canvas)) != 0) {
-			obs_data_set_string(sourceData, "canvas_uuid", obs_canvas_get_uuid(canvas));
-			obs_source_t *found = obs_get_source_by_uuid(obs_data_get_string(sourceData, "uuid"));
-			if (found) {
-				obs_canvas_t *found_canvas = obs_source_get_canvas(found);
-				if (found_canvas != canvas) {
-					obs_data_unset_user_value(sourceData, "uuid");
-				}
-				obs_canvas_release(found_canvas);
-				obs_source_release(found);
+		obs_data_t *filter = obs_data_array_item(filters, i);
+		obs_data_unset_user_value(filter, "uuid");
+		obs_data_release(filter);
+	}
+	obs_data_array_release(filters);
+}
+
+// Stamps out one copy of the template per parameter row into a single array for one import. Every copy gets new
+// uuids, and names that are already taken, by existing sources or earlier copies, get a numbered suffix.
+static obs_data_array_t *InstantiateTemplate(const SceneTemplate &sceneTemplate, const std::vector<TemplateParameters> &rows,
+					     obs_canvas_t *canvas)
+{
+	obs_data_array_t *result = obs_data_array_create();
+	std::unordered_set<std::string> used;
+	for (size_t row = 0; row < rows.size(); row++) {
+		TemplateParameters parameters = rows[row];
+		parameters.emplace("index", std::to_string(row + 1));
+		obs_data_array_t *sources = sceneTemplate.Instantiate(parameters);
+		if (!sources) {
+			blog(LOG_WARNING, "[Source Copy] Template copy %zu is not valid json", row + 1);
+			continue;
+		}
+		std::unordered_map<std::string, std::string> renamed;
+		const size_t count = obs_data_array_count(sources);
+		for (size_t i = 0; i < count; i++) {
+			obs_data_t *sourceData = obs_data_array_item(sources, i);
+			const std::string name = obs_data_get_string(sourceData, "name");
+			const std::string unique = UniqueSourceName(name, canvas, used);
+			if (unique != name) {
+				renamed.emplace(name, unique);
+				obs_data_set_string(sourceData, "name", unique.c_str());
 			}
+			obs_data_unset_user_value(sourceData, "uuid");
+			UnsetFilterUuids(sourceData);
+			obs_data_release(sourceData);
 		}
-		obs_source_t *s =
-			(canvas && obs_get_source_output_flags(obs_data_get_string(sourceData, "id")) & OBS_SOURCE_REQUIRES_CANVAS)
-				? obs_canvas_get_source_by_name(canvas, name)
-				: obs_get_source_by_name(name);
-		if (!s)
-			s = obs_load_source(sourceData);
-		if (s) {
-			sources.push_back(s);
-			if (i == count - 1 && scene &&
-			    (obs_source_get_type(s) == OBS_SOURCE_TYPE_SCENE || obs_source_get_type(s) == OBS_SOURCE_TYPE_INPUT))
-				obs_scene_add(scene, s);
+		for (size_t i = 0; i < count; i++) {
+			obs_data_t *sourceData = obs_data_array_item(sources, i);
+			RenameSceneItems(sourceData, renamed);
+			obs_data_array_push_back(result, sourceData);
+			obs_data_release(sourceData);
 		}
-		obs_scene_t *scene = obs_scene_from_source(s);
-		if (!scene)
-			scene = obs_group_from_source(s);
-		if (scene) {
-			obs_data_t *scene_settings = obs_data_get_obj(sourceData, "settings");
-			obs_source_update(s, scene_settings);
-			obs_data_release(scene_settings);
+		obs_data_array_release(sources);
+	}
+	return result;
+}
+
+static TemplateParameters GetTemplateParameters(obs_data_t *row)
+{
+	TemplateParameters parameters;
+	for (obs_data_item_t *item = obs_data_first(row); item; obs_data_item_next(&item)) {
+		const char *name = obs_data_item_get_name(item);
+		switch (obs_data_item_gettype(item)) {
+		case OBS_DATA_STRING:
+			parameters[name] = obs_data_item_get_string(item);
+			break;
+		case OBS_DATA_NUMBER:
+			if (obs_data_item_numtype(item) == OBS_DATA_NUM_INT) {
+				parameters[name] = std::to_string(obs_data_item_get_int(item));
+			} else {
+				char number[64];
+				snprintf(number, sizeof(number), "%.17g", obs_data_item_get_double(item));
+				parameters[name] = number;
+			}
+			break;
+		case OBS_DATA_BOOLEAN:
+			parameters[name] = obs_data_item_get_bool(item) ? "true" : "false";
+			break;
+		default:
+			break;
 		}
-		obs_data_release(sourceData);
 	}
+	return parameters;
+}
 
-	for (obs_source_t *source : sources)
-		obs_source_load(source);
+static std::vector<TemplateParameters> GetTemplateRows(obs_data_array_t *array)
+{
+	std::vector<TemplateParameters> rows;
+	const size_t count = obs_data_array_count(array);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *row = obs_data_array_item(array, i);
+		rows.push_back(GetTemplateParameters(row));
+		obs_data_release(row);
+	}
+	return rows;
+}
 
-	for (obs_source_t *source : sources)
-		obs_source_release(source);
+// Reads the csv row starting at pos and moves pos past it. A quoted field may span several lines.
+static std::vector<std::string> ReadCsvRow(const std::string &text, size_t &pos)
+{
+	std::vector<std::string> fields(1);
+	bool quoted = false;
+	size_t i = pos;
+	for (; i < text.size(); i++) {
+		const char c = text[i];
+		if (quoted) {
+			if (c == '"' && i + 1 < text.size() && text[i + 1] == '"') {
+				fields.back() += '"';
+				i++;
+			} else if (c == '"') {
+				quoted = false;
+			} else {
+				fields.back() += c;
+			}
+		} else if (c == '"') {
+			quoted = true;
+		} else if (c == ',') {
+			fields.emplace_back();
+		} else if (c == '\n') {
+			break;
+		} else if (c != '\r') {
+			fields.back() += c;
+		}
+	}
+	pos = i + 1;
+	return fields;
 }
 
-static void LoadSceneCanvas(obs_data_t *data, obs_canvas_t *canvas)
+// Reads a parameter table, either csv with a header row of placeholder names or a json array of objects.
+static std::vector<TemplateParameters> LoadTemplateRows(const QString &fileName)
 {
-	if (!data)
-		return;
-	obs_data_array_t *sourcesData = obs_data_get_array(data, "sources");
-	if (!sourcesData)
-		return;
-	LoadSources(sourcesData, nullptr, canvas);
-	obs_data_array_release(sourcesData);
+	std::vector<TemplateParameters> rows;
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return rows;
+	const std::string text = file.readAll().toStdString();
+	if (fileName.endsWith(".json", Qt::CaseInsensitive)) {
+		const size_t start = text.find_first_not_of(" \t\r\n");
+		const bool bare_array = start != std::string::npos && text[start] == '[';
+		obs_data_t *data = obs_data_create_from_json(bare_array ? ("{\"rows\":" + text + "}").c_str() : text.c_str());
+		obs_data_array_t *array = data ? obs_data_get_array(data, "rows") : nullptr;
+		rows = GetTemplateRows(array);
+		obs_data_array_release(array);
+		obs_data_release(data);
+		return rows;
+	}
+	std::vector<std::string> header;
+	size_t pos = 0;
+	while (pos < text.size()) {
+		const std::vector<std::string> fields = ReadCsvRow(text, pos);
+		if (fields.size() == 1 && fields[0].empty())
+			continue;
+		if (header.empty()) {
+			header = fields;
+			continue;
+		}
+		TemplateParameters parameters;
+		for (size_t i = 0; i < header.size() && i < fields.size(); i++)
+			parameters[header[i]] = fields[i];
+		rows.push_back(std::move(parameters));
+	}
+	return rows;
 }
 
-static void LoadScene(obs_data_t *data)
+static void LoadTemplate(obs_data_t *data, const std::vector<TemplateParameters> &rows, obs_canvas_t *canvas)
 {
-	LoadSceneCanvas(data, nullptr);
+	if (!data || rows.empty())
+		return;
+	const uint64_t start = os_gettime_ns();
+	SceneTemplate sceneTemplate(data);
+	obs_data_array_t *sources = InstantiateTemplate(sceneTemplate, rows, canvas);
+	blog(LOG_INFO, "[Source Copy] Instantiated %zu copies with %zu placeholders in %.1f ms", rows.size(),
+	     sceneTemplate.Placeholders().size(), (double)(os_gettime_ns() - start) / 1000000.0);
+	LoadSources(sources, nullptr, canvas, true);
+	obs_data_array_release(sources);
 }
 
-config_t *get_user_config(void)
+static void LoadScene(obs_data_t *data)
 {
-	return obs_frontend_get_user_config();
+	LoadSceneCanvas(data, nullptr);
 }
 
-obs_data_array_t *GetScriptsData()
+static std::string GetSceneCollectionPath(config_t *config)
 {
-	const auto config = get_user_config();
-	if (!config)
-		return nullptr;
-	const std::string sceneCollection = config_get_string(config, "Basic", "SceneCollection");
 	const std::string filename = config_get_string(config, "Basic", "SceneCollectionFile");
-	std::string path = obs_module_config_path("../../basic/scenes/");
+	char *dir = obs_module_config_path("../../basic/scenes/");
+	std::string path = dir;
+	bfree(dir);
 	path += filename;
 	path += ".json";
+	return path;
+}
 
-	obs_frontend_save();
-	auto data = obs_data_create_from_json_file(path.c_str());
-	if (!data)
-		return nullptr;
+static obs_data_array_t *scripts_cache = nullptr;
+static bool scripts_cache_valid = false;
 
-	auto modules = obs_data_get_obj(data, "modules");
-	auto scripts = obs_data_get_array(modules, "scripts-tool");
-	obs_data_release(modules);
+static void SetScriptsCache(obs_data_array_t *scripts)
+{
+	if (scripts)
+		obs_data_array_addref(scripts);
+	obs_data_array_release(scripts_cache);
+	scripts_cache = scripts;
+	scripts_cache_valid = true;
+}
+
+static void InvalidateScriptsCache()
+{
+	obs_data_array_release(scripts_cache);
+	scripts_cache = nullptr;
+	scripts_cache_valid = false;
+}
+
+static obs_data_array_t *ReadScriptsData(const std::string &path)
+{
+	FILE *file = os_fopen(path.c_str(), "rb");
+	if (!file)
+		return nullptr;
+	JsonScanner scanner({"modules", "scripts-tool"}, false);
+	std::string json;
+	char buffer[65536];
+	size_t read;
+	while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		if (!scanner.Feed(buffer, read, [&json](std::string &value) { json = "{\"scripts-tool\":" + value + "}"; }))
+			break;
+	}
+	fclose(file);
+	if (json.empty())
+		return nullptr;
+	obs_data_t *data = obs_data_create_from_json(json.c_str());
+	obs_data_array_t *scripts = obs_data_get_array(data, "scripts-tool");
 	obs_data_release(data);
 	return scripts;
 }
 
-void LoadScriptData(obs_data_t *script_data)
+// Takes the scripts from the list of the Scripts tool, which is current even when the tool has no signal for its changes,
+// keeping the cached settings of every path. Settings changed in the tool since the collection was last saved show up
+// after the next save, saving just to read them would write the whole collection on every menu open.
+static void RefreshScriptsCache()
+{
+	QListWidget *list = nullptr;
+	for (QWidget *widget : QApplication::topLevelWidgets()) {
+		if (widget->objectName() == "ScriptsTool")
+			list = widget->findChild<QListWidget *>("scripts");
+	}
+	if (!list)
+		return;
+	std::vector<std::string> paths;
+	for (int i = 0; i < list->count(); i++) {
+		const QString path = list->item(i)->data(Qt::UserRole).toString();
+		if (path.isEmpty())
+			return;
+		paths.push_back(QT_TO_UTF8(path));
+	}
+	std::unordered_map<std::string, obs_data_t *> cached;
+	const size_t count = obs_data_array_count(scripts_cache);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *script = obs_data_array_item(scripts_cache, i);
+		if (!cached.emplace(obs_data_get_string(script, "path"), script).second)
+			obs_data_release(script);
+	}
+	obs_data_array_t *scripts = obs_data_array_create();
+	for (const std::string &path : paths) {
+		auto it = cached.find(path);
+		if (it != cached.end()) {
+			obs_data_array_push_back(scripts, it->second);
+			continue;
+		}
+		obs_data_t *script = obs_data_create();
+		obs_data_set_string(script, "path", path.c_str());
+		obs_data_array_push_back(scripts, script);
+		obs_data_release(script);
+	}
+	for (auto &it : cached)
+		obs_data_release(it.second);
+	SetScriptsCache(scripts);
+	obs_data_array_release(scripts);
+}
+
+obs_data_array_t *GetScriptsData()
+{
+	if (!scripts_cache_valid) {
+		const auto config = get_user_config();
+		if (!config)
+			return nullptr;
+		obs_data_array_t *scripts = ReadScriptsData(GetSceneCollectionPath(config));
+		SetScriptsCache(scripts);
+		obs_data_array_release(scripts);
+	}
+	RefreshScriptsCache();
+	if (scripts_cache)
+		obs_data_array_addref(scripts_cache);
+	return scripts_cache;
+}
+
+typedef struct obs_script obs_script_t;
+typedef obs_script_t *(*obs_script_create_t)(const char *path, obs_data_t *settings);
+typedef void (*obs_script_destroy_t)(obs_script_t *script);
+
+static obs_script_create_t script_create = nullptr;
+static obs_script_destroy_t script_destroy = nullptr;
+static std::vector<obs_script_t *> injected_scripts;
+static obs_data_array_t *pending_scripts = nullptr;
+
+static bool ResolveScripting()
+{
+	if (script_create && script_destroy)
+		return true;
+#ifdef _WIN32
+	HMODULE module = GetModuleHandleW(L"obs-scripting.dll");
+	if (!module)
+		return false;
+	script_create = (obs_script_create_t)GetProcAddress(module, "obs_script_create");
+	script_destroy = (obs_script_destroy_t)GetProcAddress(module, "obs_script_destroy");
+#else
+	script_create = (obs_script_create_t)dlsym(RTLD_DEFAULT, "obs_script_create");
+	script_destroy = (obs_script_destroy_t)dlsym(RTLD_DEFAULT, "obs_script_destroy");
+#endif
+	return script_create && script_destroy;
+}
+
+static void DestroyInjectedScripts()
+{
+	for (obs_script_t *script : injected_scripts)
+		script_destroy(script);
+	injected_scripts.clear();
+}
+
+static bool InjectScript(obs_data_t *script_data)
+{
+	const char *path = obs_data_get_string(script_data, "path");
+	if (!path || !*path || !ResolveScripting())
+		return false;
+	obs_data_t *settings = obs_data_get_obj(script_data, "settings");
+	obs_script_t *script = script_create(path, settings);
+	obs_data_release(settings);
+	if (!script)
+		return false;
+	injected_scripts.push_back(script);
+
+	// The scripts tool does not know about this script, it is handed over on the next collection load
+	if (!pending_scripts)
+		pending_scripts = obs_data_array_create();
+	obs_data_array_push_back(pending_scripts, script_data);
+	return true;
+}
+
+static bool ReloadWithScript(obs_data_t *script_data)
 {
 	const auto config = get_user_config();
 	if (!config)
-		return;
+		return false;
 
 	obs_frontend_save();
 	const std::string sceneCollection = config_get_string(config, "Basic", "SceneCollection");
-	const std::string filename = config_get_string(config, "Basic", "SceneCollectionFile");
-	std::string path = obs_module_config_path("../../basic/scenes/");
-	path += filename;
-	path += ".json";
+	const std::string path = GetSceneCollectionPath(config);
 
 	auto data = obs_data_create_from_json_file(path.c_str());
 	if (!data)
-		return;
+		return false;
 
 	auto modules = obs_data_get_obj(data, "modules");
 	auto scripts = obs_data_get_array(modules, "scripts-tool");
 	obs_data_release(modules);
-	if (scripts) {
-		obs_data_array_push_back(scripts, script_data);
-		obs_data_array_release(scripts);
-		obs_data_save_json_safe(data, path.c_str(), "tmp", "bak");
-		obs_data_release(data);
-		config_set_string(config, "Basic", "SceneCollection", "Source Copy Temp");
-		config_set_string(config, "Basic", "SceneCollectionFile", "source_copy_temp");
-		obs_frontend_set_current_scene_collection(sceneCollection.c_str());
-		std::string temp_path = obs_module_config_path("../../basic/scenes/source_copy_temp.json");
-		os_unlink(temp_path.c_str());
-	} else {
+	if (!scripts) {
 		obs_data_release(data);
+		return false;
+	}
+	obs_data_array_push_back(scripts, script_data);
+	obs_data_array_release(scripts);
+	obs_data_save_json_safe(data, path.c_str(), "tmp", "bak");
+	obs_data_release(data);
+	config_set_string(config, "Basic", "SceneCollection", "Source Copy Temp");
+	config_set_string(config, "Basic", "SceneCollectionFile", "source_copy_temp");
+	obs_frontend_set_current_scene_collection(sceneCollection.c_str());
+	std::string temp_path = obs_module_config_path("../../basic/scenes/source_copy_temp.json");
+	os_unlink(temp_path.c_str());
+	return true;
+}
+
+void LoadScriptData(obs_data_t *script_data)
+{
+	const uint64_t start = os_gettime_ns();
+	if (InjectScript(script_data)) {
+		blog(LOG_INFO, "[Source Copy] script added to running scripts in %.1f ms",
+		     (double)(os_gettime_ns() - start) / 1000000.0);
+	} else if (ReloadWithScript(script_data)) {
+		blog(LOG_INFO, "[Source Copy] script added by reloading scene collection in %.1f ms",
+		     (double)(os_gettime_ns() - start) / 1000000.0);
 	}
 }
 
@@ -274,10 +2210,10 @@ static void LoadScriptMenu(QMenu *menu)
 	auto a = menu->addAction(QT_UTF8(obs_module_text("LoadScript")));
 	QObject::connect(a, &QAction::triggered, [] {
 		QString fileName = QFileDialog::getOpenFileName(nullptr, QT_UTF8(obs_module_text("LoadScript")), QString(),
-								"JSON File (*.json)");
+								FILE_FILTER);
 		if (fileName.isEmpty())
 			return;
-		obs_data_t *data = obs_data_create_from_json_file(QT_TO_UTF8(fileName));
+		obs_data_t *data = LoadDataFile(fileName);
 		if (!data)
 			return;
 		try_fix_paths(data, fileName);
@@ -286,11 +2222,7 @@ static void LoadScriptMenu(QMenu *menu)
 	});
 	a = menu->addAction(QT_UTF8(obs_module_text("PasteScript")));
 	QObject::connect(a, &QAction::triggered, [] {
-		QClipboard *clipboard = QGuiApplication::clipboard();
-		const QString strData = clipboard->text();
-		if (strData.isEmpty())
-			return;
-		const auto data = obs_data_create_from_json(QT_TO_UTF8(strData));
+		const auto data = GetClipboardData();
 		if (!data)
 			return;
 		LoadScriptData(data);
@@ -330,33 +2262,180 @@ static void LoadScriptMenu(QMenu *menu)
 			clipboard->setText(scriptData);
 		});
 	}
-	obs_data_array_release(scripts);
+	obs_data_array_release(scripts);
+}
+
+// Bumped on every change that can make a built menu show stale entries or hold dangling pointers.
+static std::atomic<uint64_t> menu_generation{1};
+
+static void InvalidateMenus(void *data, calldata_t *cd)
+{
+	UNUSED_PARAMETER(data);
+	UNUSED_PARAMETER(cd);
+	menu_generation++;
+}
+
+static const char *scene_signals[] = {"item_add", "item_remove", "reorder", "filter_add", "filter_remove", "reorder_filters"};
+
+static void ConnectSceneSignals(obs_source_t *source, bool connect)
+{
+	if (obs_source_get_type(source) != OBS_SOURCE_TYPE_SCENE)
+		return;
+	signal_handler_t *sh = obs_source_get_signal_handler(source);
+	for (const char *signal : scene_signals) {
+		if (connect)
+			signal_handler_connect(sh, signal, InvalidateMenus, nullptr);
+		else
+			signal_handler_disconnect(sh, signal, InvalidateMenus, nullptr);
+	}
+}
+
+static void SourceCreated(void *data, calldata_t *cd)
+{
+	InvalidateMenus(data, cd);
+	ConnectSceneSignals(static_cast<obs_source_t *>(calldata_ptr(cd, "source")), true);
+}
+
+static const char *global_signals[] = {"source_destroy", "source_remove", "source_rename",
+				       "canvas_create",  "canvas_remove", "canvas_rename"};
+
+static void ConnectMenuSignals(bool connect)
+{
+	signal_handler_t *sh = obs_get_signal_handler();
+	if (connect)
+		signal_handler_connect(sh, "source_create", SourceCreated, nullptr);
+	else
+		signal_handler_disconnect(sh, "source_create", SourceCreated, nullptr);
+	for (const char *signal : global_signals) {
+		if (connect)
+			signal_handler_connect(sh, signal, InvalidateMenus, nullptr);
+		else
+			signal_handler_disconnect(sh, signal, InvalidateMenus, nullptr);
+	}
+	obs_enum_scenes(
+		[](void *param, obs_source_t *source) {
+			ConnectSceneSignals(source, *static_cast<bool *>(param));
+			return true;
+		},
+		&connect);
+}
+
+// Returns true when the menu was built after the last change, so it can be shown as it is.
+static bool MenuUpToDate(QMenu *menu)
+{
+	const qulonglong generation = menu_generation;
+	if (menu->property("sourceCopyGeneration").toULongLong() == generation)
+		return true;
+	menu->setProperty("sourceCopyGeneration", generation);
+	return false;
+}
+
+// A menu shown again as it is keeps its search text, clear it so no scenes stay hidden by the last search.
+static void ResetMenuSearch(QMenu *menu)
+{
+	for (QAction *action : menu->actions()) {
+		auto wa = qobject_cast<QWidgetAction *>(action);
+		auto edit = wa ? qobject_cast<QLineEdit *>(wa->defaultWidget()) : nullptr;
+		if (edit)
+			edit->clear();
+	}
+}
+
+static obs_scene_t *GetSceneOrGroup(obs_source_t *source)
+{
+	obs_scene_t *scene = obs_scene_from_source(source);
+	return scene ? scene : obs_group_from_source(source);
+}
+
+// Menus are kept between shows, so their actions hold weak references and do nothing once the source is gone.
+static std::function<void()> WithMenuSource(obs_source_t *source, std::function<void(obs_source_t *)> action)
+{
+	std::shared_ptr<obs_weak_source_t> weak(obs_source_get_weak_source(source), obs_weak_source_release);
+	return [weak, action] {
+		obs_source_t *source = obs_weak_source_get_source(weak.get());
+		if (!source)
+			return;
+		action(source);
+		obs_source_release(source);
+	};
+}
+
+// Like WithMenuSource, a null canvas stands for the main canvas and is passed on as it is.
+static std::function<void()> WithMenuCanvas(obs_canvas_t *canvas, std::function<void(obs_canvas_t *)> action)
+{
+	if (!canvas)
+		return [action] { action(nullptr); };
+	std::shared_ptr<obs_weak_canvas_t> weak(obs_canvas_get_weak_canvas(canvas), obs_weak_canvas_release);
+	return [weak, action] {
+		obs_canvas_t *canvas = obs_weak_canvas_get_canvas(weak.get());
+		if (!canvas)
+			return;
+		action(canvas);
+		obs_canvas_release(canvas);
+	};
+}
+
+static void LogMenuBuilt(QMenu *menu)
+{
+	blog(LOG_DEBUG, "[Source Copy] Built menu '%s' with %d actions", QT_TO_UTF8(menu->title()), (int)menu->actions().size());
 }
 
 static void LoadCanvasMenu(QMenu *menu, obs_canvas_t *canvas)
 {
+	if (MenuUpToDate(menu)) {
+		ResetMenuSearch(menu);
+		return;
+	}
 	menu->clear();
 	QAction *a = menu->addAction(obs_module_text("LoadScene"));
-	QObject::connect(a, &QAction::triggered, [canvas] {
+	QObject::connect(a, &QAction::triggered, WithMenuCanvas(canvas, [](obs_canvas_t *canvas) {
 		QString fileName = QFileDialog::getOpenFileName(nullptr, QT_UTF8(obs_module_text("LoadScene")), QString(),
-								"JSON File (*.json)");
-		if (fileName.isEmpty())
+								FILE_FILTER);
+		if (fileName.isEmpty() || StreamSourcesFile(fileName, nullptr, canvas))
 			return;
-		obs_data_t *data = obs_data_create_from_json_file(QT_TO_UTF8(fileName));
+		obs_data_t *data = LoadDataFile(fileName);
 		try_fix_paths(data, fileName);
-		LoadSceneCanvas(data, canvas);
+		LoadSceneCanvas(data, canvas, true);
 		obs_data_release(data);
-	});
+	}));
 	a = menu->addAction(QT_UTF8(obs_module_text("PasteScene")));
-	QObject::connect(a, &QAction::triggered, [canvas] {
-		QClipboard *clipboard = QGuiApplication::clipboard();
-		const QString strData = clipboard->text();
-		if (strData.isEmpty())
+	QObject::connect(a, &QAction::triggered, WithMenuCanvas(canvas, [](obs_canvas_t *canvas) {
+		obs_data_t *data = GetClipboardData();
+		LoadSceneCanvas(data, canvas, true);
+		obs_data_release(data);
+	}));
+	a = menu->addAction(QT_UTF8(obs_module_text("LoadSceneArchive")));
+	QObject::connect(a, &QAction::triggered, WithMenuCanvas(canvas, [](obs_canvas_t *canvas) {
+		QString fileName = QFileDialog::getOpenFileName(nullptr, QT_UTF8(obs_module_text("LoadSceneArchive")), QString(),
+								ARCHIVE_FILTER);
+		if (fileName.isEmpty())
+			return;
+		const QString assetDir = GetArchiveAssetDir(fileName);
+		if (assetDir.isEmpty())
+			return;
+		obs_data_t *data = LoadArchive(fileName, assetDir);
+		if (!data) {
+			ShowArchiveError("LoadSceneArchiveFailed");
+			return;
+		}
+		LoadSceneCanvas(data, canvas, true);
+		obs_data_release(data);
+	}));
+	a = menu->addAction(QT_UTF8(obs_module_text("InstantiateTemplate")));
+	QObject::connect(a, &QAction::triggered, WithMenuCanvas(canvas, [](obs_canvas_t *canvas) {
+		QString fileName = QFileDialog::getOpenFileName(nullptr, QT_UTF8(obs_module_text("InstantiateTemplate")),
+								QString(), FILE_FILTER);
+		if (fileName.isEmpty())
+			return;
+		QString tableName = QFileDialog::getOpenFileName(nullptr, QT_UTF8(obs_module_text("TemplateParameters")),
+								 QString(), PARAMETER_FILTER);
+		if (tableName.isEmpty())
 			return;
-		obs_data_t *data = obs_data_create_from_json(QT_TO_UTF8(strData));
-		LoadSceneCanvas(data, canvas);
+		obs_data_t *data = LoadDataFile(fileName);
+		try_fix_paths(data, fileName);
+		LoadTemplate(data, LoadTemplateRows(tableName), canvas);
 		obs_data_release(data);
-	});
+	}));
 	auto label = new QLabel("<b>" + QT_UTF8(obs_module_text("Scenes")) + "</b>");
 	label->setAlignment(Qt::AlignCenter);
 
@@ -388,7 +2467,9 @@ static void LoadCanvasMenu(QMenu *menu, obs_canvas_t *canvas)
 
 				QMenu *submenu = menu->addMenu(obs_source_get_name(scene));
 				QObject::connect(submenu, &QMenu::aboutToShow,
-						 [submenu, scene] { LoadSourceMenu(submenu, scene, nullptr); });
+						 WithMenuSource(scene, [submenu](obs_source_t *scene) {
+							 LoadSourceMenu(submenu, scene, nullptr);
+						 }));
 				return true;
 			},
 			menu);
@@ -399,16 +2480,309 @@ static void LoadCanvasMenu(QMenu *menu, obs_canvas_t *canvas)
 			obs_source_t *source = scenes.sources.array[i];
 			QMenu *submenu = menu->addMenu(obs_source_get_name(scenes.sources.array[i]));
 			QObject::connect(submenu, &QMenu::aboutToShow,
-					 [submenu, source] { LoadSourceMenu(submenu, source, nullptr); });
+					 WithMenuSource(source, [submenu](obs_source_t *source) {
+						 LoadSourceMenu(submenu, source, nullptr);
+					 }));
 		}
 		obs_frontend_source_list_free(&scenes);
 	}
+	LogMenuBuilt(menu);
+}
+
+enum FindKind { FIND_CANVAS, FIND_SCENE, FIND_ITEM, FIND_FILTER, FIND_TRANSITION };
+
+struct FindEntry {
+	FindKind kind;
+	QString key;
+	QString label;
+	QString canvas;
+	obs_weak_source_t *source;
+	obs_weak_source_t *parent;
+	int64_t item_id;
+};
+
+static std::vector<FindEntry> find_index;
+static uint64_t find_generation = 0;
+// Entries past this come from item transitions, which change without a signal and are refreshed on every search.
+static size_t find_base_size = 0;
+
+static void ClearFindIndex()
+{
+	for (auto &entry : find_index) {
+		obs_weak_source_release(entry.source);
+		obs_weak_source_release(entry.parent);
+	}
+	find_index.clear();
+	find_generation = 0;
+	find_base_size = 0;
+}
+
+struct FindIndexContext {
+	QString canvas;
+	QString path;
+	std::unordered_set<obs_source_t *> filtered;
+};
+
+static void AddFindEntry(FindKind kind, const QString &name, const QString &label, const QString &canvas, obs_source_t *source,
+			 obs_source_t *parent = nullptr, int64_t item_id = 0)
+{
+	find_index.push_back({kind, name.toLower(), label, canvas, source ? obs_source_get_weak_source(source) : nullptr,
+			      parent ? obs_source_get_weak_source(parent) : nullptr, item_id});
+}
+
+static void IndexFilters(obs_source_t *source, const QString &path, FindIndexContext &context)
+{
+	if (!context.filtered.insert(source).second)
+		return;
+	std::vector<obs_source_t *> filters;
+	obs_source_enum_filters(
+		source, [](obs_source_t *, obs_source_t *filter, void *param) {
+			static_cast<std::vector<obs_source_t *> *>(param)->push_back(filter);
+		},
+		&filters);
+	for (obs_source_t *filter : filters) {
+		const QString name = QT_UTF8(obs_source_get_name(filter));
+		AddFindEntry(FIND_FILTER, name, path + " / " + name, context.canvas, filter, source);
+	}
+}
+
+static void IndexScene(obs_scene_t *scene, const QString &path, FindIndexContext &context)
+{
+	std::vector<obs_sceneitem_t *> items;
+	obs_scene_enum_items(scene, CollectSceneItem, &items);
+	obs_source_t *scene_source = obs_scene_get_source(scene);
+	for (obs_sceneitem_t *item : items) {
+		obs_source_t *source = obs_sceneitem_get_source(item);
+		const QString name = QT_UTF8(obs_source_get_name(source));
+		const QString itemPath = path + " / " + name;
+		const int64_t id = obs_sceneitem_get_id(item);
+		AddFindEntry(FIND_ITEM, name, itemPath, context.canvas, source, scene_source, id);
+		IndexFilters(source, itemPath, context);
+		if (obs_sceneitem_is_group(item))
+			IndexScene(obs_sceneitem_group_get_scene(item), itemPath, context);
+	}
+}
+
+// Indexes the show and hide transitions of every indexed item again, looking the items up by id. Item transitions are
+// reached through the copy/paste actions of their item.
+static void IndexItemTransitions()
+{
+	for (size_t i = find_base_size; i < find_index.size(); i++) {
+		obs_weak_source_release(find_index[i].source);
+		obs_weak_source_release(find_index[i].parent);
+	}
+	find_index.erase(find_index.begin() + (ptrdiff_t)find_base_size, find_index.end());
+	for (size_t i = 0; i < find_base_size; i++) {
+		if (find_index[i].kind != FIND_ITEM)
+			continue;
+		obs_source_t *parent = obs_weak_source_get_source(find_index[i].parent);
+		obs_scene_t *scene = parent ? GetSceneOrGroup(parent) : nullptr;
+		obs_sceneitem_t *item = scene ? obs_scene_find_sceneitem_by_id(scene, find_index[i].item_id) : nullptr;
+		for (bool show : {true, false}) {
+			obs_source_t *transition = item ? obs_sceneitem_get_transition(item, show) : nullptr;
+			if (!transition)
+				continue;
+			const QString name = QT_UTF8(obs_source_get_name(transition));
+			// Copy what is needed first, adding may move the entries.
+			const QString label = find_index[i].label + " / " + name;
+			const QString canvas = find_index[i].canvas;
+			AddFindEntry(FIND_ITEM, name, label, canvas, obs_sceneitem_get_source(item), parent, find_index[i].item_id);
+		}
+		obs_source_release(parent);
+	}
+}
+
+// Rebuilds the index only when the scene graph changed since it was last built, searching never touches libobs. Only
+// the item transitions are looked up on every open.
+static void BuildFindIndex()
+{
+	if (find_generation == menu_generation) {
+		IndexItemTransitions();
+		return;
+	}
+	ClearFindIndex();
+	find_generation = menu_generation;
+	obs_enum_canvases(
+		[](void *, obs_canvas_t *canvas) -> bool {
+			if (!canvas)
+				return true;
+			FindIndexContext context;
+			context.canvas = QT_UTF8(obs_canvas_get_name(canvas));
+			AddFindEntry(FIND_CANVAS, context.canvas, context.canvas, context.canvas, nullptr);
+			obs_canvas_enum_scenes(
+				canvas,
+				[](void *param, obs_source_t *scene) -> bool {
+					auto context = static_cast<FindIndexContext *>(param);
+					const QString name = QT_UTF8(obs_source_get_name(scene));
+					const QString path = context->canvas + " / " + name;
+					AddFindEntry(FIND_SCENE, name, path, context->canvas, scene);
+					IndexFilters(scene, path, *context);
+					IndexScene(obs_scene_from_source(scene), path, *context);
+					return true;
+				},
+				&context);
+			return true;
+		},
+		nullptr);
+	struct obs_frontend_source_list transitions = {};
+	obs_frontend_get_transitions(&transitions);
+	for (size_t i = 0; i < transitions.sources.num; i++) {
+		obs_source_t *transition = transitions.sources.array[i];
+		const QString name = QT_UTF8(obs_source_get_name(transition));
+		AddFindEntry(FIND_TRANSITION, name, QT_UTF8(obs_module_text("Transitions")) + " / " + name, QString(), transition);
+	}
+	obs_frontend_source_list_free(&transitions);
+	find_base_size = find_index.size();
+	IndexItemTransitions();
+	blog(LOG_DEBUG, "[Source Copy] Indexed %d objects for find", (int)find_index.size());
+}
+
+// Subsequence match, favouring consecutive characters and word starts. Returns INT_MIN when not all characters match.
+static int FuzzyScore(const QString &text, const QString &pattern)
+{
+	int score = 0;
+	int last = -1;
+	int streak = 0;
+	for (const QChar c : pattern) {
+		const int found = (int)text.indexOf(c, last + 1);
+		if (found < 0)
+			return INT_MIN;
+		if (found == last + 1 && last >= 0) {
+			streak++;
+			score += 5 * streak;
+		} else {
+			streak = 0;
+			score -= std::min(found - last - 1, 10);
+		}
+		if (found == 0 || !text[found - 1].isLetterOrNumber())
+			score += 10;
+		last = found;
+	}
+	if (text == pattern)
+		score += 100;
+	else if (text.startsWith(pattern))
+		score += 50;
+	return score - (int)text.size() / 4;
+}
+
+static void LoadTransitionMenu(QMenu *menu, obs_source_t *transition)
+{
+	QAction *a = menu->addAction(QT_UTF8(obs_module_text("SaveTransition")));
+	QObject::connect(a, &QAction::triggered, [transition] {
+		QString fileName = QFileDialog::getSaveFileName(nullptr, QT_UTF8(obs_module_text("SaveTransition")), QString(),
+								FILE_FILTER);
+		if (fileName.isEmpty())
+			return;
+		obs_data_t *data = obs_save_source(transition);
+		SaveDataFile(data, fileName);
+		obs_data_release(data);
+	});
+	a = menu->addAction(QT_UTF8(obs_module_text("CopyTransition")));
+	QObject::connect(a, &QAction::triggered, [transition] {
+		obs_data_t *data = obs_save_source(transition);
+		SetClipboardData(data);
+		obs_data_release(data);
+	});
+}
+
+static void ShowFindActions(const FindEntry &entry)
+{
+	QMenu menu;
+	obs_source_t *source = obs_weak_source_get_source(entry.source);
+	obs_source_t *parent = obs_weak_source_get_source(entry.parent);
+	obs_canvas_t *canvas = nullptr;
+	switch (entry.kind) {
+	case FIND_CANVAS:
+		canvas = obs_get_canvas_by_name(QT_TO_UTF8(entry.canvas));
+		if (canvas)
+			LoadCanvasMenu(&menu, canvas);
+		break;
+	case FIND_SCENE:
+		if (source)
+			LoadSourceMenu(&menu, source, nullptr);
+		break;
+	case FIND_ITEM: {
+		obs_scene_t *scene = obs_scene_from_source(parent);
+		if (!scene)
+			scene = obs_group_from_source(parent);
+		obs_sceneitem_t *item = scene ? obs_scene_find_sceneitem_by_id(scene, entry.item_id) : nullptr;
+		if (item)
+			LoadSourceMenu(&menu, obs_sceneitem_get_source(item), item);
+		break;
+	}
+	case FIND_FILTER:
+		if (source)
+			LoadFilterMenu(&menu, source);
+		break;
+	case FIND_TRANSITION:
+		if (source)
+			LoadTransitionMenu(&menu, source);
+		break;
+	}
+	if (!menu.isEmpty())
+		menu.exec(QCursor::pos());
+	obs_canvas_release(canvas);
+	obs_source_release(parent);
+	obs_source_release(source);
+}
+
+static void ShowFindDialog()
+{
+	BuildFindIndex();
+	const auto main_window = static_cast<QMainWindow *>(obs_frontend_get_main_window());
+	QDialog dialog(main_window);
+	dialog.setWindowTitle(QT_UTF8(obs_module_text("Find")));
+	auto layout = new QVBoxLayout(&dialog);
+	auto search = new QLineEdit(&dialog);
+	auto list = new QListWidget(&dialog);
+	layout->addWidget(search);
+	layout->addWidget(list);
+
+	std::vector<std::pair<int, size_t>> ranked;
+	const auto update = [&](const QString &text) {
+		const QString pattern = text.trimmed().toLower();
+		ranked.clear();
+		for (size_t i = 0; i < find_index.size(); i++) {
+			const int score = pattern.isEmpty() ? 0 : FuzzyScore(find_index[i].key, pattern);
+			if (score != INT_MIN)
+				ranked.emplace_back(-score, i);
+		}
+		const size_t count = std::min(ranked.size(), (size_t)FIND_MAX_RESULTS);
+		std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end());
+		list->clear();
+		for (size_t i = 0; i < count; i++) {
+			auto item = new QListWidgetItem(find_index[ranked[i].second].label, list);
+			item->setData(Qt::UserRole, (qulonglong)ranked[i].second);
+		}
+		if (count)
+			list->setCurrentRow(0);
+	};
+	size_t chosen = SIZE_MAX;
+	QObject::connect(search, &QLineEdit::textChanged, update);
+	QObject::connect(search, &QLineEdit::returnPressed, [&] {
+		if (QListWidgetItem *item = list->currentItem()) {
+			chosen = item->data(Qt::UserRole).toULongLong();
+			dialog.accept();
+		}
+	});
+	QObject::connect(list, &QListWidget::itemActivated, [&](QListWidgetItem *item) {
+		chosen = item->data(Qt::UserRole).toULongLong();
+		dialog.accept();
+	});
+	update(QString());
+	if (dialog.exec() == QDialog::Accepted && chosen < find_index.size())
+		ShowFindActions(find_index[chosen]);
 }
 
 static void LoadMenu(QMenu *menu)
 {
+	if (MenuUpToDate(menu))
+		return;
 	menu->clear();
 
+	menu->addAction(QT_UTF8(obs_module_text("Find")), [] { ShowFindDialog(); });
+	menu->addSeparator();
+
 	obs_enum_canvases(
 		[](void *data, obs_canvas_t *canvas) -> bool {
 			QMenu *menu = static_cast<QMenu *>(data);
@@ -416,11 +2790,43 @@ static void LoadMenu(QMenu *menu)
 				return true;
 			auto canvasMenu = menu->addMenu(QT_UTF8(obs_canvas_get_name(canvas)));
 			QObject::connect(canvasMenu, &QMenu::aboutToShow,
-					 [canvasMenu, canvas] { LoadCanvasMenu(canvasMenu, canvas); });
+					 WithMenuCanvas(canvas, [canvasMenu](obs_canvas_t *canvas) {
+						 LoadCanvasMenu(canvasMenu, canvas);
+					 }));
 			return true;
 		},
 		menu);
 
+	menu->addAction(QT_UTF8(obs_module_text("LoadAllCanvases")), [] {
+		QString fileName = QFileDialog::getOpenFileName(nullptr, QT_UTF8(obs_module_text("LoadAllCanvases")), QString(),
+								FILE_FILTER);
+		if (fileName.isEmpty())
+			return;
+		obs_data_t *data = LoadDataFile(fileName);
+		try_fix_paths(data, fileName);
+		LoadCanvases(data);
+		obs_data_release(data);
+	});
+	menu->addAction(QT_UTF8(obs_module_text("PasteAllCanvases")), [] {
+		obs_data_t *data = GetClipboardData();
+		LoadCanvases(data);
+		obs_data_release(data);
+	});
+	menu->addAction(QT_UTF8(obs_module_text("SaveAllCanvases")), [] {
+		QString fileName = QFileDialog::getSaveFileName(nullptr, QT_UTF8(obs_module_text("SaveAllCanvases")), QString(),
+								FILE_FILTER);
+		if (fileName.isEmpty())
+			return;
+		obs_data_t *data = SaveCanvases();
+		SaveDataFile(data, fileName);
+		obs_data_release(data);
+	});
+	menu->addAction(QT_UTF8(obs_module_text("CopyAllCanvases")), [] {
+		obs_data_t *data = SaveCanvases();
+		SetClipboardData(data);
+		obs_data_release(data);
+	});
+
 	menu->addSeparator();
 
 	QMenu *submenu = menu->addMenu(QT_UTF8(obs_module_text("Scripts")));
@@ -430,6 +2836,7 @@ static void LoadMenu(QMenu *menu)
 	menu->addAction(QString::fromUtf8("Source Copy (" PROJECT_VERSION ")"),
 			[] { QDesktopServices::openUrl(QUrl("https://obsproject.com/forum/resources/source-copy.1261/")); });
 	menu->addAction(QString::fromUtf8("By Exeldro"), [] { QDesktopServices::openUrl(QUrl("https://exeldro.com")); });
+	LogMenuBuilt(menu);
 }
 
 void CopyTransform(void *data, obs_hotkey_id id, obs_hotkey_t *hotkey, bool pressed)
@@ -463,18 +2870,127 @@ void PasteTransform(void *data, obs_hotkey_id id, obs_hotkey_t *hotkey, bool pre
 		t->trigger();
 }
 
+static obs_data_t *GetLayoutData(obs_scene_t *scene);
+static void LoadLayout(obs_scene_t *scene, obs_data_t *data, bool animate);
+static void TweenTick(void *param, float seconds);
+static void ClearTweens();
+
+static obs_source_t *GetEditingScene()
+{
+	if (obs_frontend_preview_program_mode_active())
+		return obs_frontend_get_current_preview_scene();
+	return obs_frontend_get_current_scene();
+}
+
+void CopyLayout(void *data, obs_hotkey_id id, obs_hotkey_t *hotkey, bool pressed)
+{
+	UNUSED_PARAMETER(data);
+	UNUSED_PARAMETER(id);
+	UNUSED_PARAMETER(hotkey);
+	if (!pressed)
+		return;
+	obs_queue_task(
+		OBS_TASK_UI,
+		[](void *) {
+			const auto main_window = static_cast<QMainWindow *>(obs_frontend_get_main_window());
+			if (!main_window->isActiveWindow())
+				return;
+			obs_source_t *source = GetEditingScene();
+			if (obs_scene_t *scene = obs_scene_from_source(source)) {
+				obs_data_t *layout = GetLayoutData(scene);
+				SetClipboardData(layout);
+				obs_data_release(layout);
+			}
+			obs_source_release(source);
+		},
+		nullptr, false);
+}
+
+void PasteLayout(void *data, obs_hotkey_id id, obs_hotkey_t *hotkey, bool pressed)
+{
+	UNUSED_PARAMETER(data);
+	UNUSED_PARAMETER(id);
+	UNUSED_PARAMETER(hotkey);
+	if (!pressed)
+		return;
+	obs_queue_task(
+		OBS_TASK_UI,
+		[](void *) {
+			const auto main_window = static_cast<QMainWindow *>(obs_frontend_get_main_window());
+			if (!main_window->isActiveWindow())
+				return;
+			obs_source_t *source = GetEditingScene();
+			if (obs_scene_t *scene = obs_scene_from_source(source)) {
+				obs_data_t *layout = GetClipboardData();
+				LoadLayout(scene, layout, false);
+				obs_data_release(layout);
+			}
+			obs_source_release(source);
+		},
+		nullptr, false);
+}
+
 obs_hotkey_id copyTransformHotkey = OBS_INVALID_HOTKEY_ID;
 obs_hotkey_id pasteTransformHotkey = OBS_INVALID_HOTKEY_ID;
+obs_hotkey_id copyLayoutHotkey = OBS_INVALID_HOTKEY_ID;
+obs_hotkey_id pasteLayoutHotkey = OBS_INVALID_HOTKEY_ID;
+
+static void frontend_preload(obs_data_t *save_data, bool saving, void *)
+{
+	if (saving)
+		return;
+	obs_data_array_t *pending = obs_data_get_array(save_data, "source-copy-scripts");
+	if (!pending)
+		return;
+	obs_data_array_t *scripts = obs_data_get_array(save_data, "scripts-tool");
+	if (!scripts) {
+		scripts = obs_data_array_create();
+		obs_data_set_array(save_data, "scripts-tool", scripts);
+	}
+	const size_t count = obs_data_array_count(pending);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *script = obs_data_array_item(pending, i);
+		const char *path = obs_data_get_string(script, "path");
+		bool found = false;
+		const size_t scripts_count = obs_data_array_count(scripts);
+		for (size_t j = 0; j < scripts_count && !found; j++) {
+			obs_data_t *existing = obs_data_array_item(scripts, j);
+			found = strcmp(path, obs_data_get_string(existing, "path")) == 0;
+			obs_data_release(existing);
+		}
+		if (!found)
+			obs_data_array_push_back(scripts, script);
+		obs_data_release(script);
+	}
+	obs_data_array_release(scripts);
+	obs_data_array_release(pending);
+	obs_data_erase(save_data, "source-copy-scripts");
+}
 
 static void frontend_save_load(obs_data_t *save_data, bool saving, void *)
 {
+	obs_data_array_t *scripts = obs_data_get_array(save_data, "scripts-tool");
+	if (scripts || !saving)
+		SetScriptsCache(scripts);
+	else
+		InvalidateScriptsCache();
+	obs_data_array_release(scripts);
+
 	if (saving) {
+		if (pending_scripts)
+			obs_data_set_array(save_data, "source-copy-scripts", pending_scripts);
 		obs_data_array_t *hotkey_save_array = obs_hotkey_save(copyTransformHotkey);
 		obs_data_set_array(save_data, "copyTransformHotkey", hotkey_save_array);
 		obs_data_array_release(hotkey_save_array);
 		hotkey_save_array = obs_hotkey_save(pasteTransformHotkey);
 		obs_data_set_array(save_data, "pasteTransformHotkey", hotkey_save_array);
 		obs_data_array_release(hotkey_save_array);
+		hotkey_save_array = obs_hotkey_save(copyLayoutHotkey);
+		obs_data_set_array(save_data, "copyLayoutHotkey", hotkey_save_array);
+		obs_data_array_release(hotkey_save_array);
+		hotkey_save_array = obs_hotkey_save(pasteLayoutHotkey);
+		obs_data_set_array(save_data, "pasteLayoutHotkey", hotkey_save_array);
+		obs_data_array_release(hotkey_save_array);
 	} else {
 		obs_data_array_t *hotkey_save_array = obs_data_get_array(save_data, "copyTransformHotkey");
 		obs_hotkey_load(copyTransformHotkey, hotkey_save_array);
@@ -482,6 +2998,45 @@ static void frontend_save_load(obs_data_t *save_data, bool saving, void *)
 		hotkey_save_array = obs_data_get_array(save_data, "pasteTransformHotkey");
 		obs_hotkey_load(pasteTransformHotkey, hotkey_save_array);
 		obs_data_array_release(hotkey_save_array);
+		hotkey_save_array = obs_data_get_array(save_data, "copyLayoutHotkey");
+		obs_hotkey_load(copyLayoutHotkey, hotkey_save_array);
+		obs_data_array_release(hotkey_save_array);
+		hotkey_save_array = obs_data_get_array(save_data, "pasteLayoutHotkey");
+		obs_hotkey_load(pasteLayoutHotkey, hotkey_save_array);
+		obs_data_array_release(hotkey_save_array);
+	}
+}
+
+static void frontend_event(enum obs_frontend_event event, void *)
+{
+	switch (event) {
+	case OBS_FRONTEND_EVENT_SCENE_LIST_CHANGED:
+	case OBS_FRONTEND_EVENT_TRANSITION_LIST_CHANGED:
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED:
+		menu_generation++;
+		break;
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGING:
+		InvalidateScriptsCache();
+		break;
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CLEANUP:
+		ClearTweens();
+		ClearFindIndex();
+		DestroyInjectedScripts();
+		InvalidateScriptsCache();
+		obs_data_array_release(pending_scripts);
+		pending_scripts = nullptr;
+		break;
+	case OBS_FRONTEND_EVENT_SCRIPTING_SHUTDOWN:
+		DestroyInjectedScripts();
+		InvalidateScriptsCache();
+		break;
+	case OBS_FRONTEND_EVENT_EXIT:
+		CancelDeferred();
+		DestroyInjectedScripts();
+		InvalidateScriptsCache();
+		break;
+	default:
+		break;
 	}
 }
 
@@ -489,11 +3044,31 @@ bool obs_module_load()
 {
 	blog(LOG_INFO, "[Source Copy] loaded version %s", PROJECT_VERSION);
 
+	if (const auto config = get_user_config()) {
+#if defined(_WIN32) || defined(__APPLE__)
+		config_set_default_bool(config, "SourceCopy", "CaseInsensitivePaths", true);
+#else
+		config_set_default_bool(config, "SourceCopy", "CaseInsensitivePaths", false);
+#endif
+		config_set_default_int(config, "SourceCopy", "AnimationDuration", 300);
+		config_set_default_string(config, "SourceCopy", "AnimationEasing", "ease-in-out");
+		// Change events save the changed source on every edit whether or not a client listens, so they are opt-in.
+		config_set_default_bool(config, "SourceCopy", "ChangeEvents", false);
+	}
+
 	copyTransformHotkey =
 		obs_hotkey_register_frontend("actionCopyTransform", obs_module_text("CopyTransform"), CopyTransform, nullptr);
 	pasteTransformHotkey =
 		obs_hotkey_register_frontend("actionPasteTransform", obs_module_text("PasteTransform"), PasteTransform, nullptr);
+	copyLayoutHotkey =
+		obs_hotkey_register_frontend("sourceCopyCopyLayout", obs_module_text("CopyLayout"), CopyLayout, nullptr);
+	pasteLayoutHotkey =
+		obs_hotkey_register_frontend("sourceCopyPasteLayout", obs_module_text("PasteLayout"), PasteLayout, nullptr);
+	obs_frontend_add_preload_callback(frontend_preload, nullptr);
 	obs_frontend_add_save_callback(frontend_save_load, nullptr);
+	obs_frontend_add_event_callback(frontend_event, nullptr);
+	obs_add_tick_callback(TweenTick, nullptr);
+	ConnectMenuSignals(true);
 
 	QAction *action = static_cast<QAction *>(obs_frontend_add_tools_menu_qaction(obs_module_text("SourceCopy")));
 	QMenu *menu = new QMenu();
@@ -504,9 +3079,22 @@ bool obs_module_load()
 
 void obs_module_unload()
 {
+	obs_frontend_remove_preload_callback(frontend_preload, nullptr);
 	obs_frontend_remove_save_callback(frontend_save_load, nullptr);
+	obs_frontend_remove_event_callback(frontend_event, nullptr);
+	obs_remove_tick_callback(TweenTick, nullptr);
+	ConnectMenuSignals(false);
+	DisconnectChangeEvents();
+	CancelDeferred();
+	ClearTweens();
+	ClearFindIndex();
+	InvalidateScriptsCache();
+	obs_data_array_release(pending_scripts);
+	pending_scripts = nullptr;
 	obs_hotkey_unregister(copyTransformHotkey);
 	obs_hotkey_unregister(pasteTransformHotkey);
+	obs_hotkey_unregister(copyLayoutHotkey);
+	obs_hotkey_unregister(pasteLayoutHotkey);
 }
 
 MODULE_EXPORT const char *obs_module_description(void)
@@ -519,88 +3107,351 @@ MODULE_EXPORT const char *obs_module_name(void)
 	return obs_module_text("SourceCopy");
 }
 
-static void AddFilterMenu(obs_source_t *parent, obs_source_t *child, void *data)
+static void LoadFilterMenu(QMenu *submenu, obs_source_t *child)
 {
-	UNUSED_PARAMETER(parent);
-	QMenu *menu = static_cast<QMenu *>(data);
-	QMenu *submenu = menu->addMenu(QT_UTF8(obs_source_get_name(child)));
 	QAction *a = submenu->addAction(QT_UTF8(obs_module_text("SaveFilter")));
-	QObject::connect(a, &QAction::triggered, [child] {
+	QObject::connect(a, &QAction::triggered, WithMenuSource(child, [](obs_source_t *child) {
 		QString fileName = QFileDialog::getSaveFileName(nullptr, QT_UTF8(obs_module_text("SaveFilter")), QString(),
-								"JSON File (*.json)");
+								FILE_FILTER);
 		if (fileName.isEmpty())
 			return;
 		obs_data_t *data = obs_save_source(child);
-		obs_data_save_json(data, QT_TO_UTF8(fileName));
+		SaveDataFile(data, fileName);
 		obs_data_release(data);
-	});
+	}));
 	a = submenu->addAction(QT_UTF8(obs_module_text("CopyFilter")));
-	QObject::connect(a, &QAction::triggered, [child] {
+	QObject::connect(a, &QAction::triggered, WithMenuSource(child, [](obs_source_t *child) {
 		obs_data_t *data = obs_save_source(child);
-		QClipboard *clipboard = QGuiApplication::clipboard();
-		clipboard->setText(QT_UTF8(obs_data_get_json(data)));
+		SetClipboardData(data);
 		obs_data_release(data);
-	});
+	}));
+}
+
+static void AddFilterMenu(obs_source_t *parent, obs_source_t *child, void *data)
+{
+	UNUSED_PARAMETER(parent);
+	QMenu *menu = static_cast<QMenu *>(data);
+	LoadFilterMenu(menu->addMenu(QT_UTF8(obs_source_get_name(child))), child);
+}
+
+static bool AddSceneItemToMenu(obs_scene_t *scene, obs_sceneitem_t *item, void *data)
+{
+	QMenu *menu = static_cast<QMenu *>(data);
+	obs_source_t *source = obs_sceneitem_get_source(item);
+	QMenu *submenu = menu->addMenu(obs_source_get_name(source));
+	// The scene menu is cached, so find the item again by id when its menu is shown.
+	const int64_t id = obs_sceneitem_get_id(item);
+	QObject::connect(submenu, &QMenu::aboutToShow,
+			 WithMenuSource(obs_scene_get_source(scene), [submenu, id](obs_source_t *parent) {
+				 obs_sceneitem_t *item = obs_scene_find_sceneitem_by_id(GetSceneOrGroup(parent), id);
+				 if (item)
+					 LoadSourceMenu(submenu, obs_sceneitem_get_source(item), item);
+			 }));
+	return true;
+}
+
+struct SaveSourcesContext {
+	std::vector<obs_source_t *> sources;
+	// Per collected source uuid the shallowest depth it was reached at.
+	std::unordered_map<std::string, int> depths;
+	// How many levels of nested scenes and groups to descend into, negative for no limit.
+	int max_depth = -1;
+	int depth = 0;
+};
+
+static bool CollectSource(obs_scene_t *scene, obs_sceneitem_t *item, void *data)
+{
+	UNUSED_PARAMETER(scene);
+	SaveSourcesContext *context = static_cast<SaveSourcesContext *>(data);
+	obs_source_t *source = obs_sceneitem_get_source(item);
+	if (!source)
+		return true;
+	// With a depth limit a source reached again less deep is descended again, its nested items may now be in reach.
+	const std::string uuid = obs_source_get_uuid(source);
+	auto it = context->depths.find(uuid);
+	const bool seen = it != context->depths.end();
+	if (seen && (context->max_depth < 0 || it->second <= context->depth))
+		return true;
+	context->depths[uuid] = context->depth;
+	obs_scene_t *nested_scene = obs_scene_from_source(source);
+	if (!nested_scene)
+		nested_scene = obs_group_from_source(source);
+	if (nested_scene && (context->max_depth < 0 || context->depth < context->max_depth)) {
+		context->depth++;
+		obs_scene_enum_items(nested_scene, CollectSource, context);
+		context->depth--;
+	}
+	if (!seen)
+		context->sources.push_back(obs_source_get_ref(source));
+	return true;
+}
+
+// Orders the collected sources so every source comes after the collected sources its scene or group items use. A
+// source reached again less deep is collected in the order it was first seen, so collection order alone is not enough.
+static void SortNestedFirst(std::vector<obs_source_t *> &sources)
+{
+	const std::unordered_set<obs_source_t *> collected(sources.begin(), sources.end());
+	std::unordered_set<obs_source_t *> visited;
+	std::vector<obs_source_t *> ordered;
+	ordered.reserve(sources.size());
+	std::function<void(obs_source_t *)> visit = [&](obs_source_t *source) {
+		if (!visited.insert(source).second)
+			return;
+		if (obs_scene_t *scene = GetSceneOrGroup(source)) {
+			std::vector<obs_sceneitem_t *> items;
+			obs_scene_enum_items(scene, CollectSceneItem, &items);
+			for (obs_sceneitem_t *item : items) {
+				obs_source_t *child = obs_sceneitem_get_source(item);
+				if (collected.count(child))
+					visit(child);
+			}
+		}
+		ordered.push_back(source);
+	};
+	for (obs_source_t *source : sources)
+		visit(source);
+	sources.swap(ordered);
+}
+
+// A projection of the saved source format, parsed from a request's "fields". "filters" selects whole
+// filters, "filters.<field>" selects single fields of each filter.
+struct SourceFields {
+	std::unordered_set<std::string> fields;
+	std::unordered_set<std::string> filter_fields;
+	bool all_filter_fields = false;
+
+	bool Has(const char *field) const { return fields.count(field) != 0; }
+
+	void Add(const std::string &field)
+	{
+		if (field.compare(0, 8, "filters.") == 0) {
+			fields.emplace("filters");
+			filter_fields.emplace(field.substr(8));
+		} else if (!field.empty()) {
+			fields.emplace(field);
+			if (field == "filters")
+				all_filter_fields = true;
+		}
+	}
+};
+
+// obs_data drops plain strings from arrays, so "fields" is a comma separated string or an array of {"value": ...}.
+static bool ParseSourceFields(obs_data_t *request_data, SourceFields &fields)
+{
+	if (!obs_data_has_user_value(request_data, "fields"))
+		return false;
+	obs_data_array_t *array = obs_data_get_array(request_data, "fields");
+	if (array) {
+		const size_t count = obs_data_array_count(array);
+		for (size_t i = 0; i < count; i++) {
+			obs_data_t *item = obs_data_array_item(array, i);
+			fields.Add(obs_data_get_string(item, "value"));
+			obs_data_release(item);
+		}
+		obs_data_array_release(array);
+		return true;
+	}
+	for (const QString &field : QString::fromUtf8(obs_data_get_string(request_data, "fields")).split(','))
+		fields.Add(QT_TO_UTF8(field.trimmed()));
+	return true;
+}
+
+static obs_data_t *GetTransformData(obs_sceneitem_t *item);
+
+// Serializes only the requested parts of a source, so unrequested settings, hotkeys and filters are never built.
+static obs_data_t *SaveSourceFields(obs_source_t *source, const SourceFields &fields)
+{
+	obs_data_t *data = obs_data_create();
+	if (fields.Has("name"))
+		obs_data_set_string(data, "name", obs_source_get_name(source));
+	if (fields.Has("uuid"))
+		obs_data_set_string(data, "uuid", obs_source_get_uuid(source));
+	if (fields.Has("id"))
+		obs_data_set_string(data, "id", obs_source_get_unversioned_id(source));
+	if (fields.Has("versioned_id"))
+		obs_data_set_string(data, "versioned_id", obs_source_get_id(source));
+	if (fields.Has("enabled"))
+		obs_data_set_bool(data, "enabled", obs_source_enabled(source));
+	if (fields.Has("muted"))
+		obs_data_set_bool(data, "muted", obs_source_muted(source));
+	if (fields.Has("volume"))
+		obs_data_set_double(data, "volume", obs_source_get_volume(source));
+	if (fields.Has("flags"))
+		obs_data_set_int(data, "flags", obs_source_get_flags(source));
+	// Unlike the other fields this saves the whole source to hash it, as expensive as requesting everything.
+	if (fields.Has("content_hash"))
+		obs_data_set_string(data, "content_hash", GetContentHash(source).c_str());
+	if (fields.Has("settings")) {
+		obs_data_t *settings = obs_source_get_settings(source);
+		obs_data_set_obj(data, "settings", settings);
+		obs_data_release(settings);
+	}
+	if (fields.Has("private_settings")) {
+		obs_data_t *settings = obs_source_get_private_settings(source);
+		obs_data_set_obj(data, "private_settings", settings);
+		obs_data_release(settings);
+	}
+	if (fields.Has("hotkeys")) {
+		obs_data_t *hotkeys = obs_hotkeys_save_source(source);
+		obs_data_set_obj(data, "hotkeys", hotkeys);
+		obs_data_release(hotkeys);
+	}
+	if (fields.Has("filters")) {
+		std::pair<const SourceFields *, obs_data_array_t *> context{&fields, obs_data_array_create()};
+		obs_source_enum_filters(
+			source,
+			[](obs_source_t *, obs_source_t *filter, void *param) {
+				auto context = static_cast<std::pair<const SourceFields *, obs_data_array_t *> *>(param);
+				obs_data_t *filterData;
+				if (context->first->all_filter_fields) {
+					filterData = obs_save_source(filter);
+				} else {
+					SourceFields filterFields;
+					filterFields.fields = context->first->filter_fields;
+					filterData = SaveSourceFields(filter, filterFields);
+				}
+				obs_data_array_push_back(context->second, filterData);
+				obs_data_release(filterData);
+			},
+			&context);
+		obs_data_set_array(data, "filters", context.second);
+		obs_data_array_release(context.second);
+	}
+	obs_scene_t *scene = obs_scene_from_source(source);
+	if (!scene)
+		scene = obs_group_from_source(source);
+	if (scene && fields.Has("items")) {
+		obs_data_array_t *items = obs_data_array_create();
+		obs_scene_enum_items(
+			scene,
+			[](obs_scene_t *, obs_sceneitem_t *item, void *param) {
+				obs_data_t *itemData = GetTransformData(item);
+				obs_source_t *itemSource = obs_sceneitem_get_source(item);
+				obs_data_set_int(itemData, "id", obs_sceneitem_get_id(item));
+				obs_data_set_string(itemData, "name", obs_source_get_name(itemSource));
+				obs_data_set_string(itemData, "source_uuid", obs_source_get_uuid(itemSource));
+				obs_data_set_bool(itemData, "visible", obs_sceneitem_visible(item));
+				obs_data_set_bool(itemData, "locked", obs_sceneitem_locked(item));
+				obs_data_array_push_back(static_cast<obs_data_array_t *>(param), itemData);
+				obs_data_release(itemData);
+				return true;
+			},
+			items);
+		obs_data_set_array(data, "items", items);
+		obs_data_array_release(items);
+	}
+	return data;
+}
+
+static void SaveSources(const std::vector<obs_source_t *> &sources, obs_data_array_t *array,
+			const SourceFields *fields = nullptr)
+{
+	for (obs_source_t *source : sources) {
+		obs_data_t *data = fields ? SaveSourceFields(source, *fields) : SaveSourceData(source);
+		obs_data_array_push_back(array, data);
+		obs_data_release(data);
+	}
+}
+
+static obs_data_t *SaveScene(obs_source_t *source, obs_scene_t *scene, const SourceFields *fields = nullptr,
+			     int max_depth = -1)
+{
+	SaveSourcesContext context;
+	context.max_depth = max_depth;
+	obs_scene_enum_items(scene, CollectSource, &context);
+	context.sources.push_back(obs_source_get_ref(source));
+	SortNestedFirst(context.sources);
+
+	obs_data_t *data = obs_data_create();
+	obs_data_array_t *sources = obs_data_array_create();
+	SaveSources(context.sources, sources, fields);
+	obs_data_set_array(data, "sources", sources);
+	obs_data_array_release(sources);
+	for (obs_source_t *s : context.sources)
+		obs_source_release(s);
+	return data;
 }
 
-static bool AddSceneItemToMenu(obs_scene_t *scene, obs_sceneitem_t *item, void *data)
+// SaveScene limited to the request's optional "fields" and "depth".
+static obs_data_t *SaveRequestedScene(obs_data_t *request_data, obs_source_t *source, obs_scene_t *scene)
 {
-	UNUSED_PARAMETER(scene);
-	QMenu *menu = static_cast<QMenu *>(data);
-	obs_source_t *source = obs_sceneitem_get_source(item);
-	QMenu *submenu = menu->addMenu(obs_source_get_name(source));
-	QObject::connect(submenu, &QMenu::aboutToShow, [submenu, source, item] { LoadSourceMenu(submenu, source, item); });
-	return true;
+	SourceFields fields;
+	const bool projected = ParseSourceFields(request_data, fields);
+	const int depth = obs_data_has_user_value(request_data, "depth") ? (int)obs_data_get_int(request_data, "depth") : -1;
+	return SaveScene(source, scene, projected ? &fields : nullptr, depth);
 }
 
-static bool SaveSource(obs_scene_t *scene, obs_sceneitem_t *item, void *data)
+// The scenes of every canvas with everything they use, each source saved once even when shared between canvases.
+static obs_data_t *SaveCanvases()
 {
-	UNUSED_PARAMETER(scene);
-	obs_data_array_t *sources = static_cast<obs_data_array_t *>(data);
-	obs_source_t *source = obs_sceneitem_get_source(item);
-	if (!source)
-		return true;
-	const char *name = obs_source_get_name(source);
-	const size_t count = obs_data_array_count(sources);
-	for (size_t i = 0; i < count; i++) {
-		obs_data_t *sourceData = obs_data_array_item(sources, i);
-		obs_data_release(sourceData);
-		if (strcmp(name, obs_data_get_string(sourceData, "name")) == 0)
+	std::pair<SaveSourcesContext, obs_data_array_t *> context{{}, obs_data_array_create()};
+	obs_enum_canvases(
+		[](void *param, obs_canvas_t *canvas) -> bool {
+			if (!canvas)
+				return true;
+			auto context = static_cast<std::pair<SaveSourcesContext, obs_data_array_t *> *>(param);
+			obs_data_t *canvasData = obs_data_create();
+			obs_data_set_string(canvasData, "uuid", obs_canvas_get_uuid(canvas));
+			obs_data_set_string(canvasData, "name", obs_canvas_get_name(canvas));
+			obs_data_array_push_back(context->second, canvasData);
+			obs_data_release(canvasData);
+			obs_canvas_enum_scenes(
+				canvas,
+				[](void *param, obs_source_t *scene) -> bool {
+					auto context = static_cast<SaveSourcesContext *>(param);
+					if (!context->depths.emplace(obs_source_get_uuid(scene), 0).second)
+						return true;
+					obs_scene_enum_items(obs_scene_from_source(scene), CollectSource, context);
+					context->sources.push_back(obs_source_get_ref(scene));
+					return true;
+				},
+				&context->first);
 			return true;
-	}
-	obs_scene_t *nested_scene = obs_scene_from_source(source);
-	if (!nested_scene)
-		nested_scene = obs_group_from_source(source);
-	if (nested_scene)
-		obs_scene_enum_items(nested_scene, SaveSource, sources);
-	obs_data_t *sceneData = obs_save_source(source);
-	obs_data_array_push_back(sources, sceneData);
-	obs_data_release(sceneData);
-	return true;
+		},
+		&context);
+
+	SortNestedFirst(context.first.sources);
+	obs_data_t *data = obs_data_create();
+	obs_data_array_t *sources = obs_data_array_create();
+	SaveSources(context.first.sources, sources);
+	for (obs_source_t *source : context.first.sources)
+		obs_source_release(source);
+	obs_data_set_array(data, "canvases", context.second);
+	obs_data_set_array(data, "sources", sources);
+	obs_data_array_release(context.second);
+	obs_data_array_release(sources);
+	return data;
 }
 
 static void LoadSingleSource(obs_scene_t *scene, obs_data_t *data)
 {
 	const char *name = obs_data_get_string(data, "name");
 	obs_source_t *source = obs_get_source_by_name(name);
-	if (!source)
+	// An existing source is kept as it is, only a source created here gets loaded.
+	const bool created = !source;
+	if (source) {
+		if (GetContentHash(source) != ContentHash(data))
+			blog(LOG_INFO, "[Source Copy] Kept existing source '%s' with different settings", name);
+	} else {
 		source = obs_load_source(data);
+	}
 	if (source) {
 		if (obs_source_get_type(source) == OBS_SOURCE_TYPE_INPUT || obs_source_get_type(source) == OBS_SOURCE_TYPE_SCENE) {
 			obs_scene_add(scene, source);
-			obs_source_load(source);
+			if (created)
+				obs_source_load(source);
 		}
 		obs_source_release(source);
 	}
 }
 
-static void LoadSource(obs_scene_t *scene, obs_data_t *data)
+static void LoadSource(obs_scene_t *scene, obs_data_t *data, bool interactive = false)
 {
 	if (!data)
 		return;
 	obs_data_array_t *sourcesData = obs_data_get_array(data, "sources");
 	if (sourcesData) {
-		LoadSources(sourcesData, scene);
+		LoadSources(sourcesData, scene, nullptr, interactive);
 		obs_data_array_release(sourcesData);
 	} else {
 		obs_data_t *sourceData = obs_data_get_obj(data, "source");
@@ -635,9 +3486,8 @@ static obs_data_t *GetTransformData(obs_sceneitem_t *item)
 	return temp;
 }
 
-void LoadTransform(obs_sceneitem_t *item, obs_data_t *data)
+static void GetTransformFromData(obs_sceneitem_t *item, obs_data_t *data, obs_transform_info &info, obs_sceneitem_crop &crop)
 {
-	obs_transform_info info{};
 	obs_sceneitem_get_info2(item, &info);
 	info.crop_to_bounds = obs_data_get_bool(data, "crop_to_bounds");
 	obs_data_get_vec2(data, "pos", &info.pos);
@@ -647,137 +3497,876 @@ void LoadTransform(obs_sceneitem_t *item, obs_data_t *data)
 	info.bounds_type = (enum obs_bounds_type)obs_data_get_int(data, "bounds_type");
 	obs_data_get_vec2(data, "bounds", &info.bounds);
 	info.bounds_alignment = obs_data_get_int(data, "bounds_alignment");
-	obs_sceneitem_set_info2(item, &info);
-	obs_sceneitem_crop crop{};
 	crop.top = obs_data_get_int(data, "top");
 	crop.bottom = obs_data_get_int(data, "bottom");
 	crop.left = obs_data_get_int(data, "left");
 	crop.right = obs_data_get_int(data, "right");
+}
+
+void LoadTransform(obs_sceneitem_t *item, obs_data_t *data)
+{
+	if (!data)
+		return;
+	obs_transform_info info{};
+	obs_sceneitem_crop crop{};
+	GetTransformFromData(item, data, info, crop);
+	obs_sceneitem_set_info2(item, &info);
 	obs_sceneitem_set_crop(item, &crop);
 }
 
+struct TransformTween {
+	obs_sceneitem_t *item;
+	obs_transform_info from;
+	obs_transform_info to;
+	obs_sceneitem_crop from_crop;
+	obs_sceneitem_crop to_crop;
+	uint64_t start;
+	uint64_t duration;
+	int easing;
+};
+
+enum { EASING_LINEAR, EASING_IN, EASING_OUT, EASING_IN_OUT };
+
+static std::mutex tweens_mutex;
+static std::vector<TransformTween> tweens;
+static std::atomic<size_t> tween_count{0};
+
+static float Ease(int easing, float t)
+{
+	switch (easing) {
+	case EASING_IN:
+		return t * t;
+	case EASING_OUT:
+		return t * (2.0f - t);
+	case EASING_IN_OUT:
+		return t * t * (3.0f - 2.0f * t);
+	default:
+		return t;
+	}
+}
+
+static float Lerp(float a, float b, float t)
+{
+	return a + (b - a) * t;
+}
+
+static int LerpCrop(int a, int b, float t)
+{
+	return (int)lroundf(Lerp((float)a, (float)b, t));
+}
+
+// Turns the short way round, from 350 to 10 degrees passes 0 instead of 180.
+static float LerpAngle(float a, float b, float t)
+{
+	float delta = fmodf(b - a, 360.0f);
+	if (delta > 180.0f)
+		delta -= 360.0f;
+	else if (delta < -180.0f)
+		delta += 360.0f;
+	return a + delta * t;
+}
+
+// Runs every active tween in one pass per graphics tick.
+static void TweenTick(void *param, float seconds)
+{
+	UNUSED_PARAMETER(param);
+	UNUSED_PARAMETER(seconds);
+	if (!tween_count)
+		return;
+	const uint64_t now = os_gettime_ns();
+	std::lock_guard<std::mutex> lock(tweens_mutex);
+	for (size_t i = 0; i < tweens.size();) {
+		TransformTween &tween = tweens[i];
+		// An item removed from its scene while tweening is dropped instead of moved.
+		if (!obs_sceneitem_get_scene(tween.item)) {
+			obs_sceneitem_release(tween.item);
+			tween = tweens.back();
+			tweens.pop_back();
+			continue;
+		}
+		const float t = now >= tween.start + tween.duration ? 1.0f : (float)(now - tween.start) / (float)tween.duration;
+		const float e = Ease(tween.easing, t);
+		// Alignment and bounds mode cannot be interpolated, they switch when the tween finishes.
+		obs_transform_info info = t < 1.0f ? tween.from : tween.to;
+		info.pos.x = Lerp(tween.from.pos.x, tween.to.pos.x, e);
+		info.pos.y = Lerp(tween.from.pos.y, tween.to.pos.y, e);
+		info.scale.x = Lerp(tween.from.scale.x, tween.to.scale.x, e);
+		info.scale.y = Lerp(tween.from.scale.y, tween.to.scale.y, e);
+		info.bounds.x = Lerp(tween.from.bounds.x, tween.to.bounds.x, e);
+		info.bounds.y = Lerp(tween.from.bounds.y, tween.to.bounds.y, e);
+		info.rot = t < 1.0f ? LerpAngle(tween.from.rot, tween.to.rot, e) : tween.to.rot;
+		obs_sceneitem_crop crop;
+		crop.left = LerpCrop(tween.from_crop.left, tween.to_crop.left, e);
+		crop.top = LerpCrop(tween.from_crop.top, tween.to_crop.top, e);
+		crop.right = LerpCrop(tween.from_crop.right, tween.to_crop.right, e);
+		crop.bottom = LerpCrop(tween.from_crop.bottom, tween.to_crop.bottom, e);
+		obs_sceneitem_defer_update_begin(tween.item);
+		obs_sceneitem_set_info2(tween.item, &info);
+		obs_sceneitem_set_crop(tween.item, &crop);
+		obs_sceneitem_defer_update_end(tween.item);
+		if (t < 1.0f) {
+			i++;
+			continue;
+		}
+		obs_sceneitem_release(tween.item);
+		tween = tweens.back();
+		tweens.pop_back();
+	}
+	tween_count = tweens.size();
+}
+
+static void ClearTweens()
+{
+	std::lock_guard<std::mutex> lock(tweens_mutex);
+	for (auto &tween : tweens)
+		obs_sceneitem_release(tween.item);
+	tweens.clear();
+	tween_count = 0;
+}
+
+// Moves the item from its current transform to the one in data over the configured duration.
+static void AnimateTransform(obs_sceneitem_t *item, obs_data_t *data)
+{
+	if (!data)
+		return;
+	const auto config = get_user_config();
+	const int64_t duration = config ? config_get_int(config, "SourceCopy", "AnimationDuration") : 0;
+	if (duration <= 0) {
+		LoadTransform(item, data);
+		return;
+	}
+	const char *easing = config_get_string(config, "SourceCopy", "AnimationEasing");
+	TransformTween tween{};
+	tween.item = item;
+	tween.start = os_gettime_ns();
+	tween.duration = (uint64_t)duration * 1000000;
+	tween.easing = EASING_IN_OUT;
+	if (easing && strcmp(easing, "linear") == 0)
+		tween.easing = EASING_LINEAR;
+	else if (easing && strcmp(easing, "ease-in") == 0)
+		tween.easing = EASING_IN;
+	else if (easing && strcmp(easing, "ease-out") == 0)
+		tween.easing = EASING_OUT;
+	GetTransformFromData(item, data, tween.to, tween.to_crop);
+
+	std::lock_guard<std::mutex> lock(tweens_mutex);
+	auto it = std::find_if(tweens.begin(), tweens.end(), [item](const TransformTween &t) { return t.item == item; });
+	if (it == tweens.end()) {
+		obs_sceneitem_addref(item);
+		it = tweens.insert(tweens.end(), tween);
+	} else {
+		*it = tween;
+	}
+	// Start from where the item is now, which may be halfway a previous tween.
+	obs_sceneitem_get_info2(item, &it->from);
+	obs_sceneitem_get_crop(item, &it->from_crop);
+	tween_count = tweens.size();
+}
+
+// Collects the items of a scene, each group followed by the items inside it.
+static bool CollectLayoutItem(obs_scene_t *scene, obs_sceneitem_t *item, void *param)
+{
+	CollectSceneItem(scene, item, param);
+	if (obs_sceneitem_is_group(item))
+		obs_sceneitem_group_enum_items(item, CollectLayoutItem, param);
+	return true;
+}
+
+// The transforms of the selected items of a scene and its groups, or of all items when none are selected.
+static obs_data_t *GetLayoutData(obs_scene_t *scene)
+{
+	std::vector<obs_sceneitem_t *> items;
+	obs_scene_enum_items(scene, CollectLayoutItem, &items);
+	const bool selected =
+		std::any_of(items.begin(), items.end(), [](obs_sceneitem_t *item) { return obs_sceneitem_selected(item); });
+	obs_data_array_t *layout = obs_data_array_create();
+	for (size_t i = 0; i < items.size(); i++) {
+		if (selected && !obs_sceneitem_selected(items[i]))
+			continue;
+		obs_source_t *source = obs_sceneitem_get_source(items[i]);
+		obs_data_t *temp = GetTransformData(items[i]);
+		obs_data_set_string(temp, "name", obs_source_get_name(source));
+		obs_data_set_string(temp, "uuid", obs_source_get_uuid(source));
+		obs_data_set_int(temp, "order", (long long)i);
+		obs_data_array_push_back(layout, temp);
+		obs_data_release(temp);
+	}
+	obs_data_t *data = obs_data_create();
+	obs_data_set_array(data, "layout", layout);
+	obs_data_array_release(layout);
+	return data;
+}
+
+static void LoadLayout(obs_scene_t *scene, obs_data_t *data, bool animate)
+{
+	obs_data_array_t *layout = data ? obs_data_get_array(data, "layout") : nullptr;
+	if (!layout)
+		return;
+	std::vector<obs_sceneitem_t *> items;
+	obs_scene_enum_items(scene, CollectLayoutItem, &items);
+	std::vector<bool> used(items.size(), false);
+	std::vector<std::pair<obs_sceneitem_t *, obs_data_t *>> matches;
+	const size_t count = obs_data_array_count(layout);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *temp = obs_data_array_item(layout, i);
+		const char *uuid = obs_data_get_string(temp, "uuid");
+		const char *name = obs_data_get_string(temp, "name");
+		size_t found = SIZE_MAX;
+		for (size_t j = 0; j < items.size() && found == SIZE_MAX; j++) {
+			if (!used[j] && strcmp(obs_source_get_uuid(obs_sceneitem_get_source(items[j])), uuid) == 0)
+				found = j;
+		}
+		for (size_t j = 0; j < items.size() && found == SIZE_MAX; j++) {
+			if (!used[j] && strcmp(obs_source_get_name(obs_sceneitem_get_source(items[j])), name) == 0)
+				found = j;
+		}
+		if (found == SIZE_MAX) {
+			obs_data_release(temp);
+			continue;
+		}
+		used[found] = true;
+		matches.emplace_back(items[found], temp);
+	}
+	obs_data_array_release(layout);
+
+	if (animate) {
+		for (auto &match : matches)
+			AnimateTransform(match.first, match.second);
+	} else {
+		for (auto &match : matches)
+			obs_sceneitem_defer_update_begin(match.first);
+		for (auto &match : matches)
+			LoadTransform(match.first, match.second);
+		for (auto &match : matches)
+			obs_sceneitem_defer_update_end(match.first);
+	}
+
+	// Reorder the matched items among the positions they already take in their own scene or group, so unmatched
+	// items stay where they are and no item moves in or out of a group.
+	std::stable_sort(matches.begin(), matches.end(), [](const auto &a, const auto &b) {
+		return obs_data_get_int(a.second, "order") < obs_data_get_int(b.second, "order");
+	});
+	std::map<obs_scene_t *, std::vector<obs_sceneitem_t *>> parents;
+	for (auto &match : matches)
+		parents[obs_sceneitem_get_scene(match.first)].push_back(match.first);
+	for (auto &parent : parents) {
+		std::vector<int> positions;
+		for (obs_sceneitem_t *item : parent.second)
+			positions.push_back(obs_sceneitem_get_order_position(item));
+		std::sort(positions.begin(), positions.end());
+		for (size_t i = 0; i < parent.second.size(); i++)
+			obs_sceneitem_set_order_position(parent.second[i], positions[i]);
+	}
+	for (auto &match : matches)
+		obs_data_release(match.second);
+}
+
+enum FilterChainMode { FILTER_CHAIN_REPLACE, FILTER_CHAIN_APPEND, FILTER_CHAIN_MERGE };
+
+static void CollectFilter(obs_source_t *parent, obs_source_t *child, void *param)
+{
+	UNUSED_PARAMETER(parent);
+	static_cast<std::vector<obs_source_t *> *>(param)->push_back(obs_source_get_ref(child));
+}
+
+static obs_data_t *GetFilterChainData(obs_source_t *source)
+{
+	std::vector<obs_source_t *> filters;
+	obs_source_enum_filters(source, CollectFilter, &filters);
+	obs_data_array_t *array = obs_data_array_create();
+	for (obs_source_t *filter : filters) {
+		obs_data_t *filterData = obs_save_source(filter);
+		obs_data_array_push_back(array, filterData);
+		obs_data_release(filterData);
+		obs_source_release(filter);
+	}
+	obs_data_t *data = obs_data_create();
+	obs_data_set_array(data, "filters", array);
+	obs_data_array_release(array);
+	return data;
+}
+
+static std::string UniqueFilterName(obs_source_t *source, const char *name, std::unordered_set<std::string> &used)
+{
+	std::string unique = name;
+	for (int i = 2;; i++) {
+		obs_source_t *existing = obs_source_get_filter_by_name(source, unique.c_str());
+		obs_source_release(existing);
+		if (!existing && used.emplace(unique).second)
+			return unique;
+		unique = std::string(name) + " " + std::to_string(i);
+	}
+}
+
+// Applies a whole filter chain while holding the graphics context, so the source is never rendered with part of it. The
+// chain is built first so only the list operations run inside that section.
+static void LoadFilterChain(obs_source_t *source, obs_data_t *data, FilterChainMode mode)
+{
+	obs_data_array_t *array = data ? obs_data_get_array(data, "filters") : nullptr;
+	if (!array)
+		return;
+	std::vector<obs_source_t *> existing;
+	obs_source_enum_filters(source, CollectFilter, &existing);
+
+	// Create the new filters up front, they are not rendered until they are added to the source.
+	struct ChainFilter {
+		obs_source_t *filter;
+		obs_data_t *data;
+		bool created;
+	};
+	std::vector<ChainFilter> chain;
+	std::unordered_set<std::string> used;
+	const size_t count = obs_data_array_count(array);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *filterData = obs_data_array_item(array, i);
+		const char *name = obs_data_get_string(filterData, "name");
+		obs_source_t *filter = nullptr;
+		if (mode == FILTER_CHAIN_MERGE) {
+			auto it = std::find_if(existing.begin(), existing.end(), [&](obs_source_t *f) {
+				return strcmp(obs_source_get_name(f), name) == 0 &&
+				       strcmp(obs_source_get_id(f), obs_data_get_string(filterData, "id")) == 0;
+			});
+			if (it != existing.end()) {
+				chain.push_back({obs_source_get_ref(*it), filterData, false});
+				continue;
+			}
+		}
+		if (mode != FILTER_CHAIN_REPLACE) {
+			const std::string unique = UniqueFilterName(source, name, used);
+			if (unique != name)
+				obs_data_set_string(filterData, "name", unique.c_str());
+		}
+		// The payload's uuids may still belong to the filters it was copied from, or to those about to be replaced.
+		obs_data_unset_user_value(filterData, "uuid");
+		filter = obs_load_source(filterData);
+		if (filter && obs_source_get_type(filter) == OBS_SOURCE_TYPE_FILTER) {
+			chain.push_back({filter, filterData, true});
+		} else {
+			obs_source_release(filter);
+			obs_data_release(filterData);
+		}
+	}
+	obs_data_array_release(array);
+
+	obs_enter_graphics();
+	if (mode == FILTER_CHAIN_REPLACE) {
+		for (obs_source_t *filter : existing)
+			obs_source_filter_remove(source, filter);
+	}
+	for (auto &entry : chain) {
+		if (entry.created)
+			obs_source_filter_add(source, entry.filter);
+		else
+			PatchSettings(entry.filter, entry.data);
+	}
+	// Merge puts the pasted chain first in payload order, the filters that were not pasted keep their relative order
+	// after it. Filters already in place are not moved.
+	if (mode == FILTER_CHAIN_MERGE) {
+		for (size_t i = 0; i < chain.size(); i++) {
+			if (obs_source_filter_get_index(source, chain[i].filter) != (int)i)
+				obs_source_filter_set_index(source, chain[i].filter, i);
+		}
+	}
+	obs_leave_graphics();
+
+	for (auto &entry : chain) {
+		if (entry.created)
+			obs_source_load(entry.filter);
+		obs_source_release(entry.filter);
+		obs_data_release(entry.data);
+	}
+	for (obs_source_t *filter : existing)
+		obs_source_release(filter);
+}
+
+static void AddFilterChainMenu(QMenu *menu, const char *text, obs_source_t *source, bool file)
+{
+	QMenu *submenu = menu->addMenu(QT_UTF8(obs_module_text(text)));
+	const std::pair<const char *, FilterChainMode> modes[] = {{"FilterChainReplace", FILTER_CHAIN_REPLACE},
+								  {"FilterChainAppend", FILTER_CHAIN_APPEND},
+								  {"FilterChainMerge", FILTER_CHAIN_MERGE}};
+	for (const auto &mode : modes) {
+		QAction *a = submenu->addAction(QT_UTF8(obs_module_text(mode.first)));
+		FilterChainMode chainMode = mode.second;
+		QObject::connect(a, &QAction::triggered, WithMenuSource(source, [file, chainMode, text](obs_source_t *source) {
+			obs_data_t *data = nullptr;
+			if (file) {
+				QString fileName = QFileDialog::getOpenFileName(nullptr, QT_UTF8(obs_module_text(text)), QString(),
+										FILE_FILTER);
+				if (fileName.isEmpty())
+					return;
+				data = LoadDataFile(fileName);
+				try_fix_paths(data, fileName);
+			} else {
+				data = GetClipboardData();
+			}
+			LoadFilterChain(source, data, chainMode);
+			obs_data_release(data);
+		}));
+	}
+}
+
+enum FanOutKind { FAN_OUT_FILTER, FAN_OUT_SHOW_TRANSITION, FAN_OUT_HIDE_TRANSITION };
+enum FanOutTargets { FAN_OUT_SELECTION, FAN_OUT_SAME_TYPE, FAN_OUT_NAME_PATTERN };
+
+struct FanOutTarget {
+	obs_weak_source_t *source;
+	obs_weak_source_t *scene;
+	int64_t item_id;
+};
+
+static obs_sceneitem_t *FindFanOutItem(obs_source_t *scene_source, int64_t id)
+{
+	obs_scene_t *scene = obs_scene_from_source(scene_source);
+	if (!scene)
+		scene = obs_group_from_source(scene_source);
+	return scene ? obs_scene_find_sceneitem_by_id(scene, id) : nullptr;
+}
+
+// The payload is loaded once per target, so each target gets a deep copy without the uuid. Loading the payload itself
+// would give every copy the same uuid and the same settings object.
+static obs_data_t *FanOutCopy(obs_data_t *data)
+{
+	obs_data_t *copy = obs_data_create_from_json(obs_data_get_json(data));
+	obs_data_unset_user_value(copy, "uuid");
+	return copy;
+}
+
+// Returns true when the filter was added, false when the source already has a filter of that name or it failed to load.
+static bool ApplyFanOutFilter(obs_source_t *source, obs_data_t *filterData)
+{
+	obs_source_t *filter = obs_source_get_filter_by_name(source, obs_data_get_string(filterData, "name"));
+	if (filter) {
+		obs_source_release(filter);
+		return false;
+	}
+	obs_data_t *copy = FanOutCopy(filterData);
+	filter = obs_load_source(copy);
+	obs_data_release(copy);
+	const bool added = filter && obs_source_get_type(filter) == OBS_SOURCE_TYPE_FILTER;
+	if (added) {
+		obs_source_filter_add(source, filter);
+		obs_source_load(filter);
+	}
+	obs_source_release(filter);
+	return added;
+}
+
+// Without transitionData the transition is cleared. Returns false when the transition failed to load, the item is then
+// left as it was.
+static bool ApplyFanOutTransition(obs_sceneitem_t *item, bool show, obs_data_t *transitionData)
+{
+	obs_data_t *copy = transitionData ? FanOutCopy(transitionData) : nullptr;
+	obs_source_t *transition = copy ? obs_load_private_source(copy) : nullptr;
+	obs_data_release(copy);
+	if (transitionData && !transition)
+		return false;
+	obs_sceneitem_set_transition(item, show, transition);
+	obs_source_release(transition);
+	return true;
+}
+
+// Undo and redo data hold the payload and per target what was done, so both can be replayed after the menu is gone.
+static void FanOutUndoRedo(const char *json, bool undo)
+{
+	obs_data_t *data = obs_data_create_from_json(json);
+	if (!data)
+		return;
+	obs_data_t *payload = obs_data_get_obj(data, "payload");
+	const int kind = (int)obs_data_get_int(data, "kind");
+	obs_data_array_t *targets = obs_data_get_array(data, "targets");
+	const size_t count = obs_data_array_count(targets);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *target = obs_data_array_item(targets, i);
+		obs_source_t *source = obs_get_source_by_uuid(obs_data_get_string(target, "uuid"));
+		if (source && kind == FAN_OUT_FILTER) {
+			if (undo) {
+				obs_source_t *filter = obs_source_get_filter_by_name(source, obs_data_get_string(payload, "name"));
+				if (filter)
+					obs_source_filter_remove(source, filter);
+				obs_source_release(filter);
+			} else {
+				ApplyFanOutFilter(source, payload);
+			}
+		} else if (source) {
+			if (obs_sceneitem_t *item = FindFanOutItem(source, obs_data_get_int(target, "id"))) {
+				obs_data_t *previous = undo ? obs_data_get_obj(target, "previous") : nullptr;
+				ApplyFanOutTransition(item, kind == FAN_OUT_SHOW_TRANSITION, undo ? previous : payload);
+				obs_data_release(previous);
+			}
+		}
+		obs_source_release(source);
+		obs_data_release(target);
+	}
+	obs_data_array_release(targets);
+	obs_data_release(payload);
+	obs_data_release(data);
+}
+
+class FanOutPaste : public QObject {
+public:
+	FanOutPaste(FanOutKind kind_, obs_data_t *payload_, std::vector<FanOutTarget> targets_)
+		: QObject(DeferredContext()),
+		  kind(kind_),
+		  payload(payload_),
+		  targets(std::move(targets_)),
+		  undo_targets(obs_data_array_create())
+	{
+		obs_data_addref(payload);
+	}
+
+	~FanOutPaste()
+	{
+		for (auto &target : targets) {
+			obs_weak_source_release(target.source);
+			obs_weak_source_release(target.scene);
+		}
+		obs_data_array_release(undo_targets);
+		obs_data_release(payload);
+	}
+
+	// Processes the targets a batch per event loop turn, then registers one undo entry and deletes itself. Pending
+	// batches are dropped with the object when CancelDeferred runs.
+	void Start()
+	{
+		QTimer::singleShot(0, this, [this] {
+			const size_t end = std::min(next + IMPORT_BATCH_SIZE, targets.size());
+			for (; next < end; next++)
+				Apply(targets[next]);
+			if (next < targets.size()) {
+				Start();
+				return;
+			}
+			Finish();
+			deleteLater();
+		});
+	}
+
+private:
+	FanOutKind kind;
+	obs_data_t *payload;
+	std::vector<FanOutTarget> targets;
+	obs_data_array_t *undo_targets;
+	size_t next = 0;
+
+	void Apply(const FanOutTarget &target)
+	{
+		obs_data_t *undo = obs_data_create();
+		if (kind == FAN_OUT_FILTER) {
+			// Only a filter added here is removed again on undo.
+			obs_source_t *source = obs_weak_source_get_source(target.source);
+			if (source && ApplyFanOutFilter(source, payload)) {
+				obs_data_set_string(undo, "uuid", obs_source_get_uuid(source));
+				obs_data_array_push_back(undo_targets, undo);
+			}
+			obs_source_release(source);
+		} else {
+			obs_source_t *scene = obs_weak_source_get_source(target.scene);
+			if (obs_sceneitem_t *item = scene ? FindFanOutItem(scene, target.item_id) : nullptr) {
+				const bool show = kind == FAN_OUT_SHOW_TRANSITION;
+				if (obs_source_t *previous = obs_sceneitem_get_transition(item, show)) {
+					obs_data_t *previousData = obs_save_source(previous);
+					obs_data_set_obj(undo, "previous", previousData);
+					obs_data_release(previousData);
+				}
+				if (ApplyFanOutTransition(item, show, payload)) {
+					obs_data_set_string(undo, "uuid", obs_source_get_uuid(scene));
+					obs_data_set_int(undo, "id", target.item_id);
+					obs_data_array_push_back(undo_targets, undo);
+				}
+			}
+			obs_source_release(scene);
+		}
+		obs_data_release(undo);
+	}
+
+	void Finish()
+	{
+		if (!obs_data_array_count(undo_targets))
+			return;
+		obs_data_t *data = obs_data_create();
+		obs_data_set_int(data, "kind", kind);
+		obs_data_set_obj(data, "payload", payload);
+		obs_data_set_array(data, "targets", undo_targets);
+		const char *json = obs_data_get_json(data);
+		const char *name = "PasteFilterTo";
+		if (kind == FAN_OUT_SHOW_TRANSITION)
+			name = "PasteShowTransitionTo";
+		else if (kind == FAN_OUT_HIDE_TRANSITION)
+			name = "PasteHideTransitionTo";
+		obs_frontend_add_undo_redo_action(
+			obs_module_text(name), [](const char *data) { FanOutUndoRedo(data, true); },
+			[](const char *data) { FanOutUndoRedo(data, false); }, json, json, false);
+		obs_data_release(data);
+	}
+};
+
+struct FanOutContext {
+	FanOutKind kind;
+	FanOutTargets by;
+	const char *id;
+	QRegularExpression pattern;
+	std::unordered_set<obs_source_t *> seen;
+	std::vector<FanOutTarget> targets;
+};
+
+static bool FanOutMatches(FanOutContext &context, obs_source_t *source, obs_sceneitem_t *item)
+{
+	switch (context.by) {
+	case FAN_OUT_SELECTION:
+		return item && obs_sceneitem_selected(item);
+	case FAN_OUT_SAME_TYPE:
+		return strcmp(obs_source_get_unversioned_id(source), context.id) == 0;
+	case FAN_OUT_NAME_PATTERN:
+		return context.pattern.match(QT_UTF8(obs_source_get_name(source))).hasMatch();
+	}
+	return false;
+}
+
+static bool CollectFanOutItem(obs_scene_t *scene, obs_sceneitem_t *item, void *param)
+{
+	auto context = static_cast<FanOutContext *>(param);
+	obs_source_t *source = obs_sceneitem_get_source(item);
+	if (FanOutMatches(*context, source, item)) {
+		if (context->kind != FAN_OUT_FILTER)
+			context->targets.push_back(
+				{nullptr, obs_source_get_weak_source(obs_scene_get_source(scene)), obs_sceneitem_get_id(item)});
+		else if (context->seen.insert(source).second)
+			context->targets.push_back({obs_source_get_weak_source(source), nullptr, 0});
+	}
+	if (obs_sceneitem_is_group(item))
+		obs_sceneitem_group_enum_items(item, CollectFanOutItem, param);
+	return true;
+}
+
+static void FanOutPasteTo(FanOutKind kind, FanOutTargets by, obs_source_t *source)
+{
+	obs_data_t *payload = GetClipboardData();
+	if (!payload)
+		return;
+	FanOutContext context{kind, by, obs_source_get_unversioned_id(source), QRegularExpression(), {}, {}};
+	if (by == FAN_OUT_NAME_PATTERN) {
+		bool ok = false;
+		const QString pattern = QInputDialog::getText(nullptr, QT_UTF8(obs_module_text("NamePattern")),
+							      QT_UTF8(obs_module_text("NamePattern")), QLineEdit::Normal,
+							      QT_UTF8(obs_source_get_name(source)), &ok);
+		if (!ok || pattern.isEmpty()) {
+			obs_data_release(payload);
+			return;
+		}
+		context.pattern = QRegularExpression(QRegularExpression::wildcardToRegularExpression(pattern),
+						     QRegularExpression::CaseInsensitiveOption);
+	}
+	if (by == FAN_OUT_SELECTION) {
+		obs_source_t *scene = GetEditingScene();
+		if (obs_scene_t *s = obs_scene_from_source(scene))
+			obs_scene_enum_items(s, CollectFanOutItem, &context);
+		obs_source_release(scene);
+	} else {
+		obs_enum_scenes(
+			[](void *param, obs_source_t *scene) {
+				auto context = static_cast<FanOutContext *>(param);
+				if (context->kind == FAN_OUT_FILTER && FanOutMatches(*context, scene, nullptr) &&
+				    context->seen.insert(scene).second)
+					context->targets.push_back({obs_source_get_weak_source(scene), nullptr, 0});
+				obs_scene_enum_items(obs_scene_from_source(scene), CollectFanOutItem, param);
+				return true;
+			},
+			&context);
+		// Inputs that are not in any scene can still receive filters.
+		if (kind == FAN_OUT_FILTER) {
+			obs_enum_sources(
+				[](void *param, obs_source_t *input) {
+					auto context = static_cast<FanOutContext *>(param);
+					if (FanOutMatches(*context, input, nullptr) && context->seen.insert(input).second)
+						context->targets.push_back({obs_source_get_weak_source(input), nullptr, 0});
+					return true;
+				},
+				&context);
+		}
+	}
+	blog(LOG_INFO, "[Source Copy] Pasting to %d targets", (int)context.targets.size());
+	(new FanOutPaste(kind, payload, std::move(context.targets)))->Start();
+	obs_data_release(payload);
+}
+
+static void AddFanOutMenu(QMenu *menu, const char *text, FanOutKind kind, obs_source_t *source)
+{
+	QMenu *submenu = menu->addMenu(QT_UTF8(obs_module_text(text)));
+	const std::pair<const char *, FanOutTargets> targets[] = {{"SelectedItems", FAN_OUT_SELECTION},
+								  {"SameSourceType", FAN_OUT_SAME_TYPE},
+								  {"NamePattern", FAN_OUT_NAME_PATTERN}};
+	for (const auto &target : targets) {
+		FanOutTargets by = target.second;
+		submenu->addAction(QT_UTF8(obs_module_text(target.first)),
+				   WithMenuSource(source, [kind, by](obs_source_t *source) { FanOutPasteTo(kind, by, source); }));
+	}
+}
+
 static void LoadSourceMenu(QMenu *menu, obs_source_t *source, obs_sceneitem_t *item)
 {
+	// Item menus show the item transitions, which change without a signal, and are small enough to rebuild.
+	if (!item && MenuUpToDate(menu))
+		return;
 	menu->clear();
 
-	obs_scene_t *scene = obs_scene_from_source(source);
-	if (!scene)
-		scene = obs_group_from_source(source);
+	obs_scene_t *scene = GetSceneOrGroup(source);
 
 	QAction *a;
 	if (scene) {
 		a = menu->addAction(
 			QT_UTF8(obs_scene_is_group(scene) ? obs_module_text("SaveGroup") : obs_module_text("SaveScene")));
-		QObject::connect(a, &QAction::triggered, [scene, source] {
+		QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
+			obs_scene_t *scene = GetSceneOrGroup(source);
 			QString fileName = QFileDialog::getSaveFileName(
 				nullptr,
 				QT_UTF8(obs_scene_is_group(scene) ? obs_module_text("SaveGroup") : obs_module_text("SaveScene")),
-				QString(), "JSON File (*.json)");
+				QString(), FILE_FILTER);
 			if (fileName.isEmpty())
 				return;
-			obs_data_t *data = obs_data_create();
-			obs_data_array_t *sources = obs_data_array_create();
-			obs_data_set_array(data, "sources", sources);
-			obs_scene_enum_items(scene, SaveSource, sources);
-			obs_data_t *sceneData = obs_save_source(source);
-			obs_data_array_push_back(sources, sceneData);
-			obs_data_release(sceneData);
-			obs_data_save_json(data, QT_TO_UTF8(fileName));
-			obs_data_array_release(sources);
+			obs_data_t *data = SaveScene(source, scene);
+			SaveDataFile(data, fileName);
 			obs_data_release(data);
-		});
+		}));
 		a = menu->addAction(
 			QT_UTF8(obs_scene_is_group(scene) ? obs_module_text("CopyGroup") : obs_module_text("CopyScene")));
-		QObject::connect(a, &QAction::triggered, [scene, source] {
-			obs_data_t *data = obs_data_create();
-			obs_data_array_t *sources = obs_data_array_create();
-			obs_data_set_array(data, "sources", sources);
-			obs_scene_enum_items(scene, SaveSource, sources);
-			obs_data_t *sceneData = obs_save_source(source);
-			obs_data_array_push_back(sources, sceneData);
-			obs_data_release(sceneData);
-			QClipboard *clipboard = QGuiApplication::clipboard();
-			clipboard->setText(QT_UTF8(obs_data_get_json(data)));
-			obs_data_array_release(sources);
+		QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
+			obs_scene_t *scene = GetSceneOrGroup(source);
+			obs_data_t *data = SaveScene(source, scene);
+			SetClipboardData(data);
 			obs_data_release(data);
-		});
+		}));
+		a = menu->addAction(QT_UTF8(obs_module_text("SaveSceneArchive")));
+		QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
+			obs_scene_t *scene = GetSceneOrGroup(source);
+			QString fileName = QFileDialog::getSaveFileName(nullptr, QT_UTF8(obs_module_text("SaveSceneArchive")),
+									QString(), ARCHIVE_FILTER);
+			if (fileName.isEmpty())
+				return;
+			obs_data_t *data = SaveScene(source, scene);
+			if (!SaveArchive(data, fileName))
+				ShowArchiveError("SaveSceneArchiveFailed");
+			obs_data_release(data);
+		}));
 		a = menu->addAction(QT_UTF8(obs_module_text("LoadSource")));
-		QObject::connect(a, &QAction::triggered, [scene] {
+		QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
+			obs_scene_t *scene = GetSceneOrGroup(source);
 			QString fileName = QFileDialog::getOpenFileName(nullptr, QT_UTF8(obs_module_text("LoadSource")), QString(),
-									"JSON File (*.json)");
-			if (fileName.isEmpty())
+									FILE_FILTER);
+			if (fileName.isEmpty() || StreamSourcesFile(fileName, scene, nullptr))
 				return;
-			obs_data_t *data = obs_data_create_from_json_file(QT_TO_UTF8(fileName));
+			obs_data_t *data = LoadDataFile(fileName);
 			try_fix_paths(data, fileName);
-			LoadSource(scene, data);
+			LoadSource(scene, data, true);
 			obs_data_release(data);
-		});
+		}));
 		a = menu->addAction(QT_UTF8(obs_module_text("PasteSource")));
-		QObject::connect(a, &QAction::triggered, [scene] {
-			QClipboard *clipboard = QGuiApplication::clipboard();
-			const QString strData = clipboard->text();
-			if (strData.isEmpty())
+		QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
+			obs_scene_t *scene = GetSceneOrGroup(source);
+			obs_data_t *data = GetClipboardData();
+			LoadSource(scene, data, true);
+			obs_data_release(data);
+		}));
+		menu->addSeparator();
+		a = menu->addAction(QT_UTF8(obs_module_text("LoadLayout")));
+		QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
+			obs_scene_t *scene = GetSceneOrGroup(source);
+			QString fileName = QFileDialog::getOpenFileName(nullptr, QT_UTF8(obs_module_text("LoadLayout")), QString(),
+									FILE_FILTER);
+			if (fileName.isEmpty())
+				return;
+			obs_data_t *data = LoadDataFile(fileName);
+			LoadLayout(scene, data, false);
+			obs_data_release(data);
+		}));
+		a = menu->addAction(QT_UTF8(obs_module_text("PasteLayout")));
+		QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
+			obs_scene_t *scene = GetSceneOrGroup(source);
+			obs_data_t *data = GetClipboardData();
+			LoadLayout(scene, data, false);
+			obs_data_release(data);
+		}));
+		a = menu->addAction(QT_UTF8(obs_module_text("PasteLayoutAnimated")));
+		QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
+			obs_scene_t *scene = GetSceneOrGroup(source);
+			obs_data_t *data = GetClipboardData();
+			LoadLayout(scene, data, true);
+			obs_data_release(data);
+		}));
+		a = menu->addAction(QT_UTF8(obs_module_text("SaveLayout")));
+		QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
+			obs_scene_t *scene = GetSceneOrGroup(source);
+			QString fileName = QFileDialog::getSaveFileName(nullptr, QT_UTF8(obs_module_text("SaveLayout")), QString(),
+									FILE_FILTER);
+			if (fileName.isEmpty())
 				return;
-			obs_data_t *data = obs_data_create_from_json(QT_TO_UTF8(strData));
-			LoadSource(scene, data);
+			obs_data_t *data = GetLayoutData(scene);
+			SaveDataFile(data, fileName);
+			obs_data_release(data);
+		}));
+		a = menu->addAction(QT_UTF8(obs_module_text("CopyLayout")));
+		QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
+			obs_scene_t *scene = GetSceneOrGroup(source);
+			obs_data_t *data = GetLayoutData(scene);
+			SetClipboardData(data);
 			obs_data_release(data);
-		});
+		}));
 	} else {
 		a = menu->addAction(QT_UTF8(obs_module_text("SaveSource")));
-		QObject::connect(a, &QAction::triggered, [source] {
+		QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
 			QString fileName = QFileDialog::getSaveFileName(nullptr, QT_UTF8(obs_module_text("SaveSource")), QString(),
-									"JSON File (*.json)");
+									FILE_FILTER);
 			if (fileName.isEmpty())
 				return;
-			obs_data_t *data = obs_save_source(source);
-			obs_data_save_json(data, QT_TO_UTF8(fileName));
+			obs_data_t *data = SaveSourceData(source);
+			SaveDataFile(data, fileName);
 			obs_data_release(data);
-		});
+		}));
 		a = menu->addAction(QT_UTF8(obs_module_text("CopySource")));
-		QObject::connect(a, &QAction::triggered, [source] {
-			obs_data_t *data = obs_save_source(source);
-			QClipboard *clipboard = QGuiApplication::clipboard();
-			clipboard->setText(QT_UTF8(obs_data_get_json(data)));
+		QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
+			obs_data_t *data = SaveSourceData(source);
+			SetClipboardData(data);
 			obs_data_release(data);
-		});
+		}));
 	}
 	if (item) {
 		menu->addSeparator();
 		a = menu->addAction(obs_module_text("LoadTransform"));
 		QObject::connect(a, &QAction::triggered, [item] {
 			QString fileName = QFileDialog::getOpenFileName(nullptr, QT_UTF8(obs_module_text("LoadTransform")),
-									QString(), "JSON File (*.json)");
+									QString(), FILE_FILTER);
 			if (fileName.isEmpty())
 				return;
-			obs_data_t *data = obs_data_create_from_json_file(QT_TO_UTF8(fileName));
+			obs_data_t *data = LoadDataFile(fileName);
 			LoadTransform(item, data);
 			obs_data_release(data);
 		});
 		a = menu->addAction(QT_UTF8(obs_module_text("PasteTransform")));
 		QObject::connect(a, &QAction::triggered, [item] {
-			QClipboard *clipboard = QGuiApplication::clipboard();
-			const QString strData = clipboard->text();
-			if (strData.isEmpty())
-				return;
-			obs_data_t *data = obs_data_create_from_json(QT_TO_UTF8(strData));
+			obs_data_t *data = GetClipboardData();
 			LoadTransform(item, data);
 			obs_data_release(data);
 		});
+		a = menu->addAction(QT_UTF8(obs_module_text("PasteTransformAnimated")));
+		QObject::connect(a, &QAction::triggered, [item] {
+			obs_data_t *data = GetClipboardData();
+			AnimateTransform(item, data);
+			obs_data_release(data);
+		});
 		a = menu->addAction(QT_UTF8(obs_module_text("SaveTransform")));
 		QObject::connect(a, &QAction::triggered, [item] {
 			QString fileName = QFileDialog::getSaveFileName(nullptr, QT_UTF8(obs_module_text("SaveSource")), QString(),
-									"JSON File (*.json)");
+									FILE_FILTER);
 			if (fileName.isEmpty())
 				return;
 			obs_data_t *temp = GetTransformData(item);
-			obs_data_save_json(temp, QT_TO_UTF8(fileName));
+			SaveDataFile(temp, fileName);
 			obs_data_release(temp);
 		});
 		a = menu->addAction(QT_UTF8(obs_module_text("CopyTransform")));
 		QObject::connect(a, &QAction::triggered, [item] {
 			obs_data_t *temp = GetTransformData(item);
-			QClipboard *clipboard = QGuiApplication::clipboard();
-			clipboard->setText(QT_UTF8(obs_data_get_json(temp)));
+			SetClipboardData(temp);
 			obs_data_release(temp);
 		});
 		menu->addSeparator();
@@ -785,10 +4374,11 @@ static void LoadSourceMenu(QMenu *menu, obs_source_t *source, obs_sceneitem_t *i
 		a = menu->addAction(obs_module_text("LoadShowTransition"));
 		QObject::connect(a, &QAction::triggered, [item] {
 			QString fileName = QFileDialog::getOpenFileName(nullptr, QT_UTF8(obs_module_text("LoadShowTransition")),
-									QString(), "JSON File (*.json)");
+									QString(), FILE_FILTER);
 			if (fileName.isEmpty())
 				return;
-			obs_data_t *data = obs_data_create_from_json_file(QT_TO_UTF8(fileName));
+			obs_data_t *data = LoadDataFile(fileName);
+			try_fix_paths(data, fileName);
 			if (const auto t = obs_load_private_source(data)) {
 				obs_sceneitem_set_transition(item, true, t);
 				obs_source_release(t);
@@ -797,11 +4387,7 @@ static void LoadSourceMenu(QMenu *menu, obs_source_t *source, obs_sceneitem_t *i
 		});
 		a = menu->addAction(QT_UTF8(obs_module_text("PasteShowTransition")));
 		QObject::connect(a, &QAction::triggered, [item] {
-			QClipboard *clipboard = QGuiApplication::clipboard();
-			const QString strData = clipboard->text();
-			if (strData.isEmpty())
-				return;
-			obs_data_t *data = obs_data_create_from_json(QT_TO_UTF8(strData));
+			obs_data_t *data = GetClipboardData();
 			if (const auto t = obs_load_private_source(data)) {
 				obs_sceneitem_set_transition(item, true, t);
 				obs_source_release(t);
@@ -809,13 +4395,16 @@ static void LoadSourceMenu(QMenu *menu, obs_source_t *source, obs_sceneitem_t *i
 			obs_data_release(data);
 		});
 
+		AddFanOutMenu(menu, "PasteShowTransitionTo", FAN_OUT_SHOW_TRANSITION, source);
+
 		a = menu->addAction(obs_module_text("LoadHideTransition"));
 		QObject::connect(a, &QAction::triggered, [item] {
 			QString fileName = QFileDialog::getOpenFileName(nullptr, QT_UTF8(obs_module_text("LoadHideTransition")),
-									QString(), "JSON File (*.json)");
+									QString(), FILE_FILTER);
 			if (fileName.isEmpty())
 				return;
-			obs_data_t *data = obs_data_create_from_json_file(QT_TO_UTF8(fileName));
+			obs_data_t *data = LoadDataFile(fileName);
+			try_fix_paths(data, fileName);
 			if (const auto t = obs_load_private_source(data)) {
 				obs_sceneitem_set_transition(item, false, t);
 				obs_source_release(t);
@@ -824,67 +4413,62 @@ static void LoadSourceMenu(QMenu *menu, obs_source_t *source, obs_sceneitem_t *i
 		});
 		a = menu->addAction(QT_UTF8(obs_module_text("PasteHideTransition")));
 		QObject::connect(a, &QAction::triggered, [item] {
-			QClipboard *clipboard = QGuiApplication::clipboard();
-			const QString strData = clipboard->text();
-			if (strData.isEmpty())
-				return;
-			obs_data_t *data = obs_data_create_from_json(QT_TO_UTF8(strData));
+			obs_data_t *data = GetClipboardData();
 			if (const auto t = obs_load_private_source(data)) {
 				obs_sceneitem_set_transition(item, false, t);
 				obs_source_release(t);
 			}
 			obs_data_release(data);
 		});
+		AddFanOutMenu(menu, "PasteHideTransitionTo", FAN_OUT_HIDE_TRANSITION, source);
 
 		auto st = obs_sceneitem_get_transition(item, true);
 		if (st) {
 			a = menu->addAction(QT_UTF8(obs_module_text("SaveShowTransition")));
-			QObject::connect(a, &QAction::triggered, [st] {
+			QObject::connect(a, &QAction::triggered, WithMenuSource(st, [](obs_source_t *st) {
 				QString fileName = QFileDialog::getSaveFileName(
-					nullptr, QT_UTF8(obs_module_text("SaveShowTransition")), QString(), "JSON File (*.json)");
+					nullptr, QT_UTF8(obs_module_text("SaveShowTransition")), QString(), FILE_FILTER);
 				if (fileName.isEmpty())
 					return;
 				obs_data_t *temp = obs_save_source(st);
-				obs_data_save_json(temp, QT_TO_UTF8(fileName));
+				SaveDataFile(temp, fileName);
 				obs_data_release(temp);
-			});
+			}));
 			a = menu->addAction(QT_UTF8(obs_module_text("CopyShowTransition")));
-			QObject::connect(a, &QAction::triggered, [st] {
+			QObject::connect(a, &QAction::triggered, WithMenuSource(st, [](obs_source_t *st) {
 				obs_data_t *temp = obs_save_source(st);
-				QClipboard *clipboard = QGuiApplication::clipboard();
-				clipboard->setText(QT_UTF8(obs_data_get_json(temp)));
+				SetClipboardData(temp);
 				obs_data_release(temp);
-			});
+			}));
 		}
 		auto ht = obs_sceneitem_get_transition(item, false);
 		if (ht) {
 			a = menu->addAction(QT_UTF8(obs_module_text("SaveHideTransition")));
-			QObject::connect(a, &QAction::triggered, [ht] {
+			QObject::connect(a, &QAction::triggered, WithMenuSource(ht, [](obs_source_t *ht) {
 				QString fileName = QFileDialog::getSaveFileName(
-					nullptr, QT_UTF8(obs_module_text("SaveHideTransition")), QString(), "JSON File (*.json)");
+					nullptr, QT_UTF8(obs_module_text("SaveHideTransition")), QString(), FILE_FILTER);
 				if (fileName.isEmpty())
 					return;
 				obs_data_t *temp = obs_save_source(ht);
-				obs_data_save_json(temp, QT_TO_UTF8(fileName));
+				SaveDataFile(temp, fileName);
 				obs_data_release(temp);
-			});
+			}));
 			a = menu->addAction(QT_UTF8(obs_module_text("CopyHideTransition")));
-			QObject::connect(a, &QAction::triggered, [ht] {
+			QObject::connect(a, &QAction::triggered, WithMenuSource(ht, [](obs_source_t *ht) {
 				obs_data_t *temp = obs_save_source(ht);
-				QClipboard *clipboard = QGuiApplication::clipboard();
-				clipboard->setText(QT_UTF8(obs_data_get_json(temp)));
+				SetClipboardData(temp);
 				obs_data_release(temp);
-			});
+			}));
 		}
 	}
 	menu->addSeparator();
 	a = menu->addAction(QT_UTF8(obs_module_text("LoadFilter")));
-	QObject::connect(a, &QAction::triggered, [source] {
+	QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
 		QString fileName = QFileDialog::getOpenFileName(nullptr, QT_UTF8(obs_module_text("LoadFilter")), QString(),
-								"JSON File (*.json)");
+								FILE_FILTER);
 		if (fileName.isEmpty())
 			return;
-		obs_data_t *data = obs_data_create_from_json_file(QT_TO_UTF8(fileName));
+		obs_data_t *data = LoadDataFile(fileName);
 		if (!data)
 			return;
 		const char *name = obs_data_get_string(data, "name");
@@ -899,14 +4483,10 @@ static void LoadSourceMenu(QMenu *menu, obs_source_t *source, obs_sceneitem_t *i
 		}
 		obs_source_release(filter);
 		obs_data_release(data);
-	});
+	}));
 	a = menu->addAction(QT_UTF8(obs_module_text("PasteFilter")));
-	QObject::connect(a, &QAction::triggered, [source] {
-		QClipboard *clipboard = QGuiApplication::clipboard();
-		const QString strData = clipboard->text();
-		if (strData.isEmpty())
-			return;
-		obs_data_t *data = obs_data_create_from_json(QT_TO_UTF8(strData));
+	QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
+		obs_data_t *data = GetClipboardData();
 		if (!data)
 			return;
 		const char *name = obs_data_get_string(data, "name");
@@ -920,7 +4500,26 @@ static void LoadSourceMenu(QMenu *menu, obs_source_t *source, obs_sceneitem_t *i
 		}
 		obs_source_release(filter);
 		obs_data_release(data);
-	});
+	}));
+	AddFanOutMenu(menu, "PasteFilterTo", FAN_OUT_FILTER, source);
+	AddFilterChainMenu(menu, "LoadFilterChain", source, true);
+	AddFilterChainMenu(menu, "PasteFilterChain", source, false);
+	a = menu->addAction(QT_UTF8(obs_module_text("SaveAllFilters")));
+	QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
+		QString fileName = QFileDialog::getSaveFileName(nullptr, QT_UTF8(obs_module_text("SaveAllFilters")), QString(),
+								FILE_FILTER);
+		if (fileName.isEmpty())
+			return;
+		obs_data_t *data = GetFilterChainData(source);
+		SaveDataFile(data, fileName);
+		obs_data_release(data);
+	}));
+	a = menu->addAction(QT_UTF8(obs_module_text("CopyAllFilters")));
+	QObject::connect(a, &QAction::triggered, WithMenuSource(source, [](obs_source_t *source) {
+		obs_data_t *data = GetFilterChainData(source);
+		SetClipboardData(data);
+		obs_data_release(data);
+	}));
 
 	if (scene) {
 		auto label = new QLabel("<b>" + QT_UTF8(obs_module_text("Sources")) + "</b>");
@@ -946,91 +4545,659 @@ static void LoadSourceMenu(QMenu *menu, obs_source_t *source, obs_sceneitem_t *i
 		menu->removeAction(wa);
 		delete wa;
 	}
+	LogMenuBuilt(menu);
+}
+
+static void *vendor;
+
+void websocket_add_scene(obs_data_t *request_data, obs_data_t *response_data, void *param)
+{
+	UNUSED_PARAMETER(param);
+	obs_queue_task(OBS_TASK_UI, (obs_task_t)LoadScene, request_data, true);
+	obs_data_set_bool(response_data, "success", true);
+}
+
+struct AddSceneJob {
+	long long id;
+	obs_data_t *data;
+	uint64_t start;
+
+	~AddSceneJob() { obs_data_release(data); }
+};
+
+static std::atomic<long long> next_job_id{1};
+
+static void EmitAddSceneCompleted(const AddSceneJob *job, const ImportResult &result)
+{
+	if (!vendor)
+		return;
+	obs_data_t *event_data = obs_data_create();
+	obs_data_set_int(event_data, "job_id", job->id);
+	obs_data_set_bool(event_data, "success", result.errors.empty());
+	obs_data_array_t *sources = obs_data_array_create();
+	for (const auto &created : result.created) {
+		obs_data_t *source = obs_data_create();
+		obs_data_set_string(source, "name", created.first.c_str());
+		obs_data_set_string(source, "uuid", created.second.c_str());
+		obs_data_array_push_back(sources, source);
+		obs_data_release(source);
+	}
+	obs_data_set_array(event_data, "sources", sources);
+	obs_data_array_release(sources);
+	obs_data_array_t *skipped = obs_data_array_create();
+	for (const auto &name : result.skipped) {
+		obs_data_t *source = obs_data_create();
+		obs_data_set_string(source, "name", name.c_str());
+		obs_data_array_push_back(skipped, source);
+		obs_data_release(source);
+	}
+	obs_data_set_array(event_data, "skipped", skipped);
+	obs_data_array_release(skipped);
+	obs_data_array_t *changed = obs_data_array_create();
+	for (const auto &name : result.changed) {
+		obs_data_t *source = obs_data_create();
+		obs_data_set_string(source, "name", name.c_str());
+		obs_data_array_push_back(changed, source);
+		obs_data_release(source);
+	}
+	obs_data_set_array(event_data, "changed", changed);
+	obs_data_array_release(changed);
+	obs_data_array_t *errors = obs_data_array_create();
+	for (const auto &message : result.errors) {
+		obs_data_t *error = obs_data_create();
+		obs_data_set_string(error, "error", message.c_str());
+		obs_data_array_push_back(errors, error);
+		obs_data_release(error);
+	}
+	obs_data_set_array(event_data, "errors", errors);
+	obs_data_array_release(errors);
+	obs_data_set_double(event_data, "elapsed_ms", (double)(os_gettime_ns() - job->start) / 1000000.0);
+	obs_websocket_vendor_emit_event(vendor, "add_scene_completed", event_data);
+	obs_data_release(event_data);
+}
+
+// The job is owned by the completion callback of its import, so it is freed with the import also when CancelDeferred
+// drops it on exit.
+static void RunAddSceneJob(void *param)
+{
+	std::shared_ptr<AddSceneJob> job(static_cast<AddSceneJob *>(param));
+	obs_canvas_t *canvas = nullptr;
+	const char *canvas_name = obs_data_get_string(job->data, "canvas");
+	if (strlen(canvas_name)) {
+		canvas = obs_get_canvas_by_name(canvas_name);
+		// The canvas was removed after the request was accepted, don't import into another one instead.
+		if (!canvas) {
+			ImportResult result;
+			result.errors.push_back(std::string("canvas not found ") + canvas_name);
+			EmitAddSceneCompleted(job.get(), result);
+			return;
+		}
+	}
+	obs_data_array_t *sourcesData = obs_data_get_array(job->data, "sources");
+	auto import = new SourceImport(sourcesData, nullptr, canvas);
+	import->SetUpdateExisting(obs_data_get_bool(job->data, "update_existing"));
+	obs_data_array_release(sourcesData);
+	obs_canvas_release(canvas);
+	obs_data_release(job->data);
+	job->data = nullptr;
+	import->Start(nullptr, [job](const ImportResult &result) { EmitAddSceneCompleted(job.get(), result); });
+}
+
+void websocket_add_scene_async(obs_data_t *request_data, obs_data_t *response_data, void *param)
+{
+	UNUSED_PARAMETER(param);
+	obs_data_array_t *sourcesData = obs_data_get_array(request_data, "sources");
+	if (!sourcesData) {
+		obs_data_set_string(response_data, "error", "sources not set");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	obs_data_array_release(sourcesData);
+	const char *canvas_name = obs_data_get_string(request_data, "canvas");
+	if (strlen(canvas_name)) {
+		obs_canvas_t *canvas = obs_get_canvas_by_name(canvas_name);
+		if (!canvas) {
+			obs_data_set_string(response_data, "error", "canvas not found");
+			obs_data_set_bool(response_data, "success", false);
+			return;
+		}
+		obs_canvas_release(canvas);
+	}
+	const long long job_id = next_job_id++;
+	obs_data_addref(request_data);
+	obs_queue_task(OBS_TASK_UI, RunAddSceneJob, new AddSceneJob{job_id, request_data, os_gettime_ns()}, false);
+	obs_data_set_int(response_data, "job_id", job_id);
+	obs_data_set_bool(response_data, "success", true);
+}
+
+void websocket_get_version(obs_data_t *request_data, obs_data_t *response_data, void *param)
+{
+	UNUSED_PARAMETER(param);
+	UNUSED_PARAMETER(request_data);
+	obs_data_set_string(response_data, "version", PROJECT_VERSION);
+	obs_data_set_bool(response_data, "success", true);
+}
+
+void websocket_get_current_scene(obs_data_t *request_data, obs_data_t *response_data, void *param)
+{
+	UNUSED_PARAMETER(param);
+	obs_source_t *source = nullptr;
+	const char *canvas_name = obs_data_get_string(request_data, "canvas");
+	if (strlen(canvas_name)) {
+		obs_canvas_t *canvas = obs_get_canvas_by_name(canvas_name);
+		if (!canvas) {
+			obs_data_set_string(response_data, "error", "canvas not found");
+			obs_data_set_bool(response_data, "success", false);
+			return;
+		}
+		source = obs_canvas_get_channel(canvas, 0);
+		if (source && obs_source_get_type(source) == OBS_SOURCE_TYPE_TRANSITION) {
+			obs_source_t *ts = obs_transition_get_active_source(source);
+			if (ts) {
+				obs_source_release(source);
+				source = ts;
+			}
+		}
+		obs_canvas_release(canvas);
+	} else {
+		source = obs_frontend_get_current_scene();
+	}
+	if (!source) {
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	obs_scene_t *scene = obs_scene_from_source(source);
+	obs_data_t *data = SaveRequestedScene(request_data, source, scene);
+	obs_data_array_t *sources = obs_data_get_array(data, "sources");
+	obs_data_set_array(response_data, "sources", sources);
+	obs_data_array_release(sources);
+	obs_data_release(data);
+	obs_source_release(source);
+	obs_data_set_bool(response_data, "success", true);
+}
+
+// Looks up the source named by key in the request, within the optional "canvas", and returns a new reference.
+static obs_source_t *GetRequestSource(obs_data_t *request_data, const char *key, SourceSnapshot &snapshot,
+				      obs_data_t *response_data)
+{
+	const char *name = obs_data_get_string(request_data, key);
+	obs_canvas_t *canvas = nullptr;
+	const char *canvas_name = obs_data_get_string(request_data, "canvas");
+	if (strlen(canvas_name)) {
+		canvas = obs_get_canvas_by_name(canvas_name);
+		if (!canvas) {
+			obs_data_set_string(response_data, "error", "canvas not found");
+			obs_data_set_bool(response_data, "success", false);
+			return nullptr;
+		}
+	}
+	obs_source_t *source = obs_source_get_ref(snapshot.Find(name, canvas));
+	obs_canvas_release(canvas);
+	if (!source) {
+		obs_data_set_string(response_data, "error", strcmp(key, "scene") == 0 ? "scene not found" : "source not found");
+		obs_data_set_bool(response_data, "success", false);
+	}
+	return source;
+}
+
+static void GetScene(obs_data_t *request_data, obs_data_t *response_data, SourceSnapshot &snapshot)
+{
+	const char *name = obs_data_get_string(request_data, "scene");
+	if (!name || !strlen(name)) {
+		obs_data_set_string(response_data, "error", "scene not set");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+
+	obs_source_t *source = GetRequestSource(request_data, "scene", snapshot, response_data);
+	if (!source)
+		return;
+	obs_scene_t *scene = obs_scene_from_source(source);
+	if (!scene) {
+		obs_source_release(source);
+		obs_data_set_string(response_data, "error", "not a scene");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	obs_data_t *data = SaveRequestedScene(request_data, source, scene);
+	obs_data_array_t *sources = obs_data_get_array(data, "sources");
+	obs_data_set_array(response_data, "sources", sources);
+	obs_data_array_release(sources);
+	obs_data_release(data);
+	obs_source_release(source);
+	obs_data_set_bool(response_data, "success", true);
+}
+
+void websocket_get_scene(obs_data_t *request_data, obs_data_t *response_data, void *param)
+{
+	UNUSED_PARAMETER(param);
+	SourceSnapshot snapshot;
+	GetScene(request_data, response_data, snapshot);
+}
+
+// Source uuid -> name and hash of the saved source.
+typedef std::unordered_map<std::string, std::pair<std::string, uint64_t>> SceneRevision;
+
+static std::mutex revisions_mutex;
+// Scene uuid -> its latest revisions by token, so clients polling different scenes do not evict each other's tokens.
+static std::unordered_map<std::string, std::map<uint64_t, SceneRevision>> revisions;
+static uint64_t next_revision = 0;
+
+static obs_source_t *GetRequestScene(obs_data_t *request_data, obs_data_t *response_data)
+{
+	const char *name = obs_data_get_string(request_data, "scene");
+	obs_source_t *source = nullptr;
+	if (!name || !strlen(name)) {
+		source = obs_frontend_get_current_scene();
+	} else {
+		const char *canvas_name = obs_data_get_string(request_data, "canvas");
+		if (strlen(canvas_name)) {
+			obs_canvas_t *canvas = obs_get_canvas_by_name(canvas_name);
+			if (!canvas) {
+				obs_data_set_string(response_data, "error", "canvas not found");
+				obs_data_set_bool(response_data, "success", false);
+				return nullptr;
+			}
+			source = obs_canvas_get_source_by_name(canvas, name);
+			obs_canvas_release(canvas);
+		} else {
+			source = obs_get_source_by_name(name);
+		}
+	}
+	if (!source) {
+		obs_data_set_string(response_data, "error", "scene not found");
+		obs_data_set_bool(response_data, "success", false);
+		return nullptr;
+	}
+	if (!obs_scene_from_source(source)) {
+		obs_source_release(source);
+		obs_data_set_string(response_data, "error", "not a scene");
+		obs_data_set_bool(response_data, "success", false);
+		return nullptr;
+	}
+	return source;
+}
+
+void websocket_get_scene_diff(obs_data_t *request_data, obs_data_t *response_data, void *param)
+{
+	UNUSED_PARAMETER(param);
+	obs_source_t *source = GetRequestScene(request_data, response_data);
+	if (!source)
+		return;
+	obs_data_t *data = SaveScene(source, obs_scene_from_source(source));
+	obs_data_array_t *saved = obs_data_get_array(data, "sources");
+	obs_data_release(data);
+
+	SceneRevision current;
+	const std::string scene_uuid = obs_source_get_uuid(source);
+	obs_source_release(source);
+	const size_t count = obs_data_array_count(saved);
+	std::vector<uint64_t> hashes(count);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *item = obs_data_array_item(saved, i);
+		hashes[i] = HashString(obs_data_get_json(item));
+		current[obs_data_get_string(item, "uuid")] = {obs_data_get_string(item, "name"), hashes[i]};
+		obs_data_release(item);
+	}
+
+	obs_data_array_t *changed = obs_data_array_create();
+	obs_data_array_t *removed = obs_data_array_create();
+	std::lock_guard<std::mutex> lock(revisions_mutex);
+	auto &history = revisions[scene_uuid];
+	const SceneRevision *previous = nullptr;
+	const char *token = obs_data_get_string(request_data, "token");
+	if (strlen(token)) {
+		auto it = history.find(strtoull(token, nullptr, 10));
+		if (it != history.end())
+			previous = &it->second;
+	}
+	const bool full = previous == nullptr;
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *item = obs_data_array_item(saved, i);
+		if (previous) {
+			auto it = previous->find(obs_data_get_string(item, "uuid"));
+			if (it == previous->end() || it->second.second != hashes[i])
+				obs_data_array_push_back(changed, item);
+		} else {
+			obs_data_array_push_back(changed, item);
+		}
+		obs_data_release(item);
+	}
+	if (previous) {
+		for (const auto &it : *previous) {
+			if (current.count(it.first))
+				continue;
+			obs_data_t *item = obs_data_create();
+			obs_data_set_string(item, "uuid", it.first.c_str());
+			obs_data_set_string(item, "name", it.second.first.c_str());
+			obs_data_array_push_back(removed, item);
+			obs_data_release(item);
+		}
+	}
+	obs_data_array_release(saved);
+
+	// A scene that did not change keeps its latest token, so polling an idle scene does not use up its history.
+	uint64_t revision;
+	if (!history.empty() && history.rbegin()->second == current) {
+		revision = history.rbegin()->first;
+	} else {
+		// Tokens start at the monotonic clock, so within one boot a token kept from an earlier run of OBS is older
+		// than every token of this run and is never found. After a reboot the clock restarts and this does not hold.
+		if (!next_revision)
+			next_revision = os_gettime_ns();
+		revision = next_revision++;
+		history.emplace(revision, std::move(current));
+		while (history.size() > SCENE_DIFF_MAX_REVISIONS)
+			history.erase(history.begin());
+	}
+
+	obs_data_set_string(response_data, "token", std::to_string(revision).c_str());
+	obs_data_set_bool(response_data, "full", full);
+	obs_data_set_array(response_data, "sources", changed);
+	obs_data_set_array(response_data, "removed", removed);
+	obs_data_array_release(changed);
+	obs_data_array_release(removed);
+	obs_data_set_bool(response_data, "success", true);
+}
+
+// Finds the existing source a patch entry is for, by uuid and then by name, or through the mirror links when given.
+static obs_source_t *FindPatchTarget(obs_data_t *data, obs_canvas_t *canvas, MirrorUuids *uuids)
+{
+	if (uuids)
+		return uuids->Match(obs_data_get_string(data, "uuid"), obs_data_get_string(data, "name"), canvas);
+	obs_source_t *source = obs_get_source_by_uuid(obs_data_get_string(data, "uuid"));
+	if (source)
+		return source;
+	const char *name = obs_data_get_string(data, "name");
+	if (canvas)
+		return obs_canvas_get_source_by_name(canvas, name);
+	return obs_get_source_by_name(name);
+}
+
+static void ApplyScenePatch(obs_data_t *request_data, obs_data_t *response_data, MirrorUuids *uuids = nullptr)
+{
+	obs_canvas_t *canvas = nullptr;
+	const char *canvas_name = obs_data_get_string(request_data, "canvas");
+	if (strlen(canvas_name)) {
+		canvas = obs_get_canvas_by_name(canvas_name);
+		if (!canvas) {
+			obs_data_set_string(response_data, "error", "canvas not found");
+			obs_data_set_bool(response_data, "success", false);
+			return;
+		}
+	}
+
+	// Sources of a patch with "canvases", like the sources_changed event, are placed by their saved canvas_uuid.
+	obs_data_array_t *canvasesData = obs_data_get_array(request_data, "canvases");
+	auto canvases = GetCanvasMap(canvasesData);
+	obs_data_array_release(canvasesData);
+
+	obs_data_array_t *sourcesData = obs_data_get_array(request_data, "sources");
+	obs_data_array_t *create = obs_data_array_create();
+	std::vector<std::pair<obs_source_t *, obs_data_t *>> existing;
+	const size_t count = obs_data_array_count(sourcesData);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *data = obs_data_array_item(sourcesData, i);
+		auto target = canvases.find(obs_data_get_string(data, "canvas_uuid"));
+		obs_source_t *source = FindPatchTarget(data, target != canvases.end() ? target->second : canvas, uuids);
+		if (source) {
+			existing.emplace_back(source, data);
+		} else {
+			obs_data_array_push_back(create, data);
+			obs_data_release(data);
+		}
+	}
+	obs_data_array_release(sourcesData);
+
+	// New sources first, so updated scenes can reference them.
+	std::unique_ptr<SourceImport> import(canvases.empty() ? new SourceImport(create, nullptr, canvas, uuids)
+							      : new SourceImport(create, canvases, uuids));
+	obs_data_array_release(create);
+	for (auto &it : canvases)
+		obs_canvas_release(it.second);
+	import->Run();
+	obs_data_array_t *created = obs_data_array_create();
+	for (const auto &it : import->Result().created) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "name", it.first.c_str());
+		obs_data_set_string(item, "uuid", it.second.c_str());
+		obs_data_array_push_back(created, item);
+		obs_data_release(item);
+	}
+	obs_data_array_t *errors = obs_data_array_create();
+	for (const auto &error : import->Result().errors) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "error", error.c_str());
+		obs_data_array_push_back(errors, item);
+		obs_data_release(item);
+	}
+
+	obs_data_array_t *updated = obs_data_array_create();
+	for (auto &it : existing) {
+		if (uuids)
+			uuids->MapItems(it.second);
+		if (PatchSource(it.first, it.second)) {
+			obs_data_t *item = obs_data_create();
+			obs_data_set_string(item, "name", obs_source_get_name(it.first));
+			obs_data_set_string(item, "uuid", obs_source_get_uuid(it.first));
+			obs_data_array_push_back(updated, item);
+			obs_data_release(item);
+		}
+		obs_source_release(it.first);
+		obs_data_release(it.second);
+	}
+
+	obs_data_array_t *removedData = obs_data_get_array(request_data, "removed");
+	obs_data_array_t *removed = obs_data_array_create();
+	const size_t removedCount = obs_data_array_count(removedData);
+	for (size_t i = 0; i < removedCount; i++) {
+		// Only an exact uuid match is removed, a source that merely has the same name is left alone.
+		obs_data_t *data = obs_data_array_item(removedData, i);
+		const char *uuid = obs_data_get_string(data, "uuid");
+		obs_source_t *source = uuids ? uuids->Find(uuid) : obs_get_source_by_uuid(uuid);
+		if (uuids)
+			uuids->Unlink(uuid);
+		if (source) {
+			obs_source_remove(source);
+			obs_data_array_push_back(removed, data);
+			obs_source_release(source);
+		}
+		obs_data_release(data);
+	}
+	obs_data_array_release(removedData);
+	obs_canvas_release(canvas);
+
+	obs_data_set_array(response_data, "created", created);
+	obs_data_set_array(response_data, "updated", updated);
+	obs_data_set_array(response_data, "removed", removed);
+	obs_data_set_array(response_data, "errors", errors);
+	obs_data_array_release(created);
+	obs_data_array_release(updated);
+	obs_data_array_release(removed);
+	obs_data_array_release(errors);
+	obs_data_set_bool(response_data, "success", true);
 }
 
-static void *vendor;
+void websocket_apply_scene_patch(obs_data_t *request_data, obs_data_t *response_data, void *param)
+{
+	UNUSED_PARAMETER(param);
+	obs_data_array_t *sourcesData = obs_data_get_array(request_data, "sources");
+	obs_data_array_t *removedData = obs_data_get_array(request_data, "removed");
+	const bool empty = !sourcesData && !removedData;
+	obs_data_array_release(sourcesData);
+	obs_data_array_release(removedData);
+	if (empty) {
+		obs_data_set_string(response_data, "error", "sources not set");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	obs_data_t *args[] = {request_data, response_data};
+	obs_queue_task(
+		OBS_TASK_UI, [](void *param) {
+			auto args = static_cast<obs_data_t **>(param);
+			ApplyScenePatch(args[0], args[1]);
+		},
+		args, true);
+}
 
-void websocket_add_scene(obs_data_t *request_data, obs_data_t *response_data, void *param)
+void websocket_get_canvases(obs_data_t *request_data, obs_data_t *response_data, void *param)
 {
+	UNUSED_PARAMETER(request_data);
 	UNUSED_PARAMETER(param);
-	obs_queue_task(OBS_TASK_UI, (obs_task_t)LoadScene, request_data, true);
+	obs_data_t *data = SaveCanvases();
+	obs_data_apply(response_data, data);
+	obs_data_release(data);
 	obs_data_set_bool(response_data, "success", true);
 }
 
-void websocket_get_version(obs_data_t *request_data, obs_data_t *response_data, void *param)
+static void AddCanvases(obs_data_t *request_data, obs_data_t *response_data, MirrorUuids *uuids = nullptr)
 {
-	UNUSED_PARAMETER(param);
-	UNUSED_PARAMETER(request_data);
-	obs_data_set_string(response_data, "version", PROJECT_VERSION);
+	SourceImport *import = CreateCanvasesImport(request_data, uuids);
+	if (!import) {
+		obs_data_set_string(response_data, "error", "canvases or sources not set");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	import->SetUpdateExisting(obs_data_get_bool(request_data, "update_existing"));
+	import->Run();
+	obs_data_array_t *created = obs_data_array_create();
+	for (const auto &it : import->Result().created) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "name", it.first.c_str());
+		obs_data_set_string(item, "uuid", it.second.c_str());
+		obs_data_array_push_back(created, item);
+		obs_data_release(item);
+	}
+	obs_data_array_t *errors = obs_data_array_create();
+	for (const auto &error : import->Result().errors) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "error", error.c_str());
+		obs_data_array_push_back(errors, item);
+		obs_data_release(item);
+	}
+	delete import;
+	obs_data_set_array(response_data, "created", created);
+	obs_data_set_array(response_data, "errors", errors);
+	obs_data_array_release(created);
+	obs_data_array_release(errors);
 	obs_data_set_bool(response_data, "success", true);
 }
 
-void websocket_get_current_scene(obs_data_t *request_data, obs_data_t *response_data, void *param)
+static void InstantiateTemplateRequest(obs_data_t *request_data, obs_data_t *response_data)
 {
-	UNUSED_PARAMETER(param);
-	UNUSED_PARAMETER(request_data);
-	obs_source_t *source = nullptr;
+	obs_data_t *templateData = obs_data_get_obj(request_data, "template");
+	obs_data_array_t *rowsData = obs_data_get_array(request_data, "rows");
+	const std::vector<TemplateParameters> rows = GetTemplateRows(rowsData);
+	obs_data_array_release(rowsData);
+	if (!templateData || rows.empty()) {
+		obs_data_release(templateData);
+		obs_data_set_string(response_data, "error", "template or rows not set");
+		obs_data_set_bool(response_data, "success", false);
+		return;
+	}
+	obs_canvas_t *canvas = nullptr;
 	const char *canvas_name = obs_data_get_string(request_data, "canvas");
 	if (strlen(canvas_name)) {
-		obs_canvas_t *canvas = obs_get_canvas_by_name(canvas_name);
+		canvas = obs_get_canvas_by_name(canvas_name);
 		if (!canvas) {
+			obs_data_release(templateData);
 			obs_data_set_string(response_data, "error", "canvas not found");
 			obs_data_set_bool(response_data, "success", false);
 			return;
 		}
-		source = obs_canvas_get_channel(canvas, 0);
-		if (source && obs_source_get_type(source) == OBS_SOURCE_TYPE_TRANSITION) {
-			obs_source_t *ts = obs_transition_get_active_source(source);
-			if (ts) {
-				obs_source_release(source);
-				source = ts;
-			}
-		}
-		obs_canvas_release(canvas);
-	} else {
-		source = obs_frontend_get_current_scene();
-	}
-	if (!source) {
-		obs_data_set_bool(response_data, "success", false);
-		return;
 	}
-	obs_scene_t *scene = obs_scene_from_source(source);
-	obs_data_array_t *sources = obs_data_array_create();
-	obs_data_set_array(response_data, "sources", sources);
-	obs_scene_enum_items(scene, SaveSource, sources);
-	obs_data_t *sceneData = obs_save_source(source);
-	obs_data_array_push_back(sources, sceneData);
-	obs_data_release(sceneData);
+	SceneTemplate sceneTemplate(templateData);
+	obs_data_release(templateData);
+	obs_data_array_t *sources = InstantiateTemplate(sceneTemplate, rows, canvas);
+	SourceImport import(sources, nullptr, canvas);
 	obs_data_array_release(sources);
-	obs_source_release(source);
+	obs_canvas_release(canvas);
+	import.Run();
+	obs_data_array_t *created = obs_data_array_create();
+	for (const auto &it : import.Result().created) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "name", it.first.c_str());
+		obs_data_set_string(item, "uuid", it.second.c_str());
+		obs_data_array_push_back(created, item);
+		obs_data_release(item);
+	}
+	obs_data_array_t *errors = obs_data_array_create();
+	for (const auto &error : import.Result().errors) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "error", error.c_str());
+		obs_data_array_push_back(errors, item);
+		obs_data_release(item);
+	}
+	obs_data_set_array(response_data, "created", created);
+	obs_data_set_array(response_data, "errors", errors);
+	obs_data_array_release(created);
+	obs_data_array_release(errors);
 	obs_data_set_bool(response_data, "success", true);
 }
 
-void websocket_get_scene(obs_data_t *request_data, obs_data_t *response_data, void *param)
+void websocket_instantiate_template(obs_data_t *request_data, obs_data_t *response_data, void *param)
 {
 	UNUSED_PARAMETER(param);
-	const char *name = obs_data_get_string(request_data, "scene");
+	obs_data_t *args[] = {request_data, response_data};
+	obs_queue_task(
+		OBS_TASK_UI, [](void *param) {
+			auto args = static_cast<obs_data_t **>(param);
+			InstantiateTemplateRequest(args[0], args[1]);
+		},
+		args, true);
+}
+
+void websocket_add_canvases(obs_data_t *request_data, obs_data_t *response_data, void *param)
+{
+	UNUSED_PARAMETER(param);
+	obs_data_t *args[] = {request_data, response_data};
+	obs_queue_task(
+		OBS_TASK_UI, [](void *param) {
+			auto args = static_cast<obs_data_t **>(param);
+			AddCanvases(args[0], args[1]);
+		},
+		args, true);
+}
+
+static void GetSource(obs_data_t *request_data, obs_data_t *response_data, SourceSnapshot &snapshot)
+{
+	const char *name = obs_data_get_string(request_data, "source");
 	if (!name || !strlen(name)) {
-		obs_data_set_string(response_data, "error", "scene not set");
+		obs_data_set_string(response_data, "error", "source not set");
 		obs_data_set_bool(response_data, "success", false);
 		return;
 	}
 
+	obs_source_t *source = GetRequestSource(request_data, "source", snapshot, response_data);
+	if (!source)
+		return;
+	SourceFields fields;
+	obs_data_t *data = ParseSourceFields(request_data, fields) ? SaveSourceFields(source, fields) : obs_save_source(source);
+	obs_data_set_obj(response_data, "source", data);
+	obs_data_release(data);
+	obs_source_release(source);
+	obs_data_set_bool(response_data, "success", true);
+}
+
+void websocket_get_source(obs_data_t *request_data, obs_data_t *response_data, void *param)
+{
+	UNUSED_PARAMETER(param);
+	SourceSnapshot snapshot;
+	GetSource(request_data, response_data, snapshot);
+}
+
+// Must run on the UI thread.
+static void AddSource(obs_data_t *request_data, obs_data_t *response_data, SourceSnapshot &snapshot)
+{
 	obs_source_t *source = nullptr;
-	const char *canvas_name = obs_data_get_string(request_data, "canvas");
-	if (strlen(canvas_name)) {
-		obs_canvas_t *canvas = obs_get_canvas_by_name(canvas_name);
-		if (!canvas) {
-			obs_data_set_string(response_data, "error", "canvas not found");
-			obs_data_set_bool(response_data, "success", false);
+	const char *name = obs_data_get_string(request_data, "scene");
+	if (name && strlen(name)) {
+		source = GetRequestSource(request_data, "scene", snapshot, response_data);
+		if (!source)
 			return;
-		}
-		source = obs_canvas_get_source_by_name(canvas, name);
-		obs_canvas_release(canvas);
 	} else {
-		source = obs_get_source_by_name(name);
+		source = obs_frontend_get_current_scene();
 	}
-
 	if (!source) {
 		obs_data_set_string(response_data, "error", "scene not found");
 		obs_data_set_bool(response_data, "success", false);
@@ -1043,89 +5210,442 @@ void websocket_get_scene(obs_data_t *request_data, obs_data_t *response_data, vo
 		obs_data_set_bool(response_data, "success", false);
 		return;
 	}
-	obs_data_array_t *sources = obs_data_array_create();
-	obs_data_set_array(response_data, "sources", sources);
-	obs_scene_enum_items(scene, SaveSource, sources);
-	obs_data_t *sceneData = obs_save_source(source);
-	obs_data_array_push_back(sources, sceneData);
-	obs_data_release(sceneData);
-	obs_data_array_release(sources);
+	LoadSource(scene, request_data);
+	snapshot.ForgetMissing();
 	obs_source_release(source);
 	obs_data_set_bool(response_data, "success", true);
 }
 
-void websocket_get_source(obs_data_t *request_data, obs_data_t *response_data, void *param)
+void websocket_add_source(obs_data_t *request_data, obs_data_t *response_data, void *param)
 {
 	UNUSED_PARAMETER(param);
-	const char *name = obs_data_get_string(request_data, "source");
-	if (!name || !strlen(name)) {
+	obs_data_t *args[] = {request_data, response_data};
+	obs_queue_task(
+		OBS_TASK_UI, [](void *param) {
+			auto args = static_cast<obs_data_t **>(param);
+			SourceSnapshot snapshot;
+			AddSource(args[0], args[1], snapshot);
+		},
+		args, true);
+}
+
+// Patches an existing source in place from the saved "source" object, looked up by its name.
+static void UpdateSource(obs_data_t *request_data, obs_data_t *response_data, SourceSnapshot &snapshot)
+{
+	obs_data_t *data = obs_data_get_obj(request_data, "source");
+	if (!data) {
 		obs_data_set_string(response_data, "error", "source not set");
 		obs_data_set_bool(response_data, "success", false);
 		return;
 	}
+	obs_data_t *lookup = obs_data_create();
+	obs_data_set_string(lookup, "source", obs_data_get_string(data, "name"));
+	obs_data_set_string(lookup, "canvas", obs_data_get_string(request_data, "canvas"));
+	obs_source_t *source = GetRequestSource(lookup, "source", snapshot, response_data);
+	obs_data_release(lookup);
+	if (source) {
+		obs_data_set_bool(response_data, "changed", PatchSource(source, data));
+		obs_data_set_bool(response_data, "success", true);
+		obs_source_release(source);
+	}
+	obs_data_release(data);
+}
 
-	obs_source_t *source = nullptr;
-	const char *canvas_name = obs_data_get_string(request_data, "canvas");
-	if (strlen(canvas_name)) {
-		obs_canvas_t *canvas = obs_get_canvas_by_name(canvas_name);
-		if (!canvas) {
-			obs_data_set_string(response_data, "error", "canvas not found");
-			obs_data_set_bool(response_data, "success", false);
-			return;
+// Runs an ordered list of operations in one UI task, sharing one name lookup snapshot between them.
+static void RunBatch(obs_data_t *request_data, obs_data_t *response_data)
+{
+	const uint64_t start = os_gettime_ns();
+	SourceSnapshot snapshot;
+	obs_data_array_t *operations = obs_data_get_array(request_data, "operations");
+	obs_data_array_t *results = obs_data_array_create();
+	const bool stop_on_error = obs_data_get_bool(request_data, "stop_on_error");
+	bool success = true;
+	const size_t count = obs_data_array_count(operations);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *operation = obs_data_array_item(operations, i);
+		obs_data_t *result = obs_data_create();
+		const char *op = obs_data_get_string(operation, "op");
+		if (strcmp(op, "get_source") == 0) {
+			GetSource(operation, result, snapshot);
+		} else if (strcmp(op, "get_scene") == 0) {
+			GetScene(operation, result, snapshot);
+		} else if (strcmp(op, "add_source") == 0) {
+			AddSource(operation, result, snapshot);
+		} else if (strcmp(op, "update_source") == 0) {
+			UpdateSource(operation, result, snapshot);
+		} else {
+			obs_data_set_string(result, "error", "unknown op");
+			obs_data_set_bool(result, "success", false);
 		}
-		source = obs_canvas_get_source_by_name(canvas, name);
-		obs_canvas_release(canvas);
-	} else {
-		source = obs_get_source_by_name(name);
+		obs_data_set_string(result, "op", op);
+		obs_data_array_push_back(results, result);
+		const bool ok = obs_data_get_bool(result, "success");
+		obs_data_release(result);
+		obs_data_release(operation);
+		success &= ok;
+		if (!ok && stop_on_error)
+			break;
 	}
-	if (!source) {
-		obs_data_set_string(response_data, "error", "source not found");
+	obs_data_array_release(operations);
+	obs_data_set_array(response_data, "results", results);
+	obs_data_array_release(results);
+	obs_data_set_bool(response_data, "success", success);
+	blog(LOG_INFO, "[Source Copy] batch of %zu operations took %.1f ms", count, (os_gettime_ns() - start) / 1000000.0);
+}
+
+void websocket_batch(obs_data_t *request_data, obs_data_t *response_data, void *param)
+{
+	UNUSED_PARAMETER(param);
+	obs_data_array_t *operations = obs_data_get_array(request_data, "operations");
+	if (!operations) {
+		obs_data_set_string(response_data, "error", "operations not set");
 		obs_data_set_bool(response_data, "success", false);
 		return;
 	}
-	obs_data_t *data = obs_save_source(source);
-	obs_data_set_obj(response_data, "source", data);
-	obs_data_release(data);
-	obs_source_release(source);
-	obs_data_set_bool(response_data, "success", true);
+	obs_data_array_release(operations);
+	obs_data_t *args[] = {request_data, response_data};
+	obs_queue_task(
+		OBS_TASK_UI, [](void *param) {
+			auto args = static_cast<obs_data_t **>(param);
+			RunBatch(args[0], args[1]);
+		},
+		args, true);
 }
 
-void websocket_add_source(obs_data_t *request_data, obs_data_t *response_data, void *param)
+static std::mutex changes_mutex;
+static std::unordered_set<std::string> changed_sources;
+static std::unordered_map<std::string, std::string> removed_sources;
+static std::atomic<bool> changes_pending{false};
+static std::atomic<bool> changes_queued{false};
+static uint64_t last_changes_emit = 0;
+static uint64_t change_seq = 0;
+// Identifies this run of the leader, so followers notice when its sequence numbers restart.
+static const uint64_t change_epoch = os_gettime_ns();
+
+static uint64_t WallClockMs()
+{
+	return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+		       std::chrono::system_clock::now().time_since_epoch())
+		.count();
+}
+
+// Records the source whose saved state changed; filters and scene item changes count as a change of their parent.
+static void SourceChanged(void *data, calldata_t *cd)
+{
+	UNUSED_PARAMETER(data);
+	auto source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	if (!source) {
+		auto scene = static_cast<obs_scene_t *>(calldata_ptr(cd, "scene"));
+		source = scene ? obs_scene_get_source(scene) : nullptr;
+	}
+	if (source && obs_source_get_type(source) == OBS_SOURCE_TYPE_FILTER)
+		source = obs_filter_get_parent(source);
+	if (!source)
+		return;
+	std::lock_guard<std::mutex> lock(changes_mutex);
+	changed_sources.emplace(obs_source_get_uuid(source));
+	changes_pending = true;
+}
+
+static void SourceRemoved(void *data, calldata_t *cd)
+{
+	UNUSED_PARAMETER(data);
+	auto source = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	if (!source || obs_source_get_type(source) == OBS_SOURCE_TYPE_FILTER) {
+		SourceChanged(data, cd);
+		return;
+	}
+	std::lock_guard<std::mutex> lock(changes_mutex);
+	changed_sources.erase(obs_source_get_uuid(source));
+	removed_sources[obs_source_get_uuid(source)] = obs_source_get_name(source);
+	changes_pending = true;
+}
+
+static const char *source_change_signals[] = {"update", "filter_add", "filter_remove", "reorder_filters"};
+static const char *scene_change_signals[] = {"item_add",       "item_remove",  "reorder",
+					     "item_transform", "item_visible", "item_locked"};
+
+static void ConnectSourceChanges(obs_source_t *source, bool connect)
+{
+	signal_handler_t *sh = obs_source_get_signal_handler(source);
+	for (const char *signal : source_change_signals) {
+		if (connect)
+			signal_handler_connect(sh, signal, SourceChanged, nullptr);
+		else
+			signal_handler_disconnect(sh, signal, SourceChanged, nullptr);
+	}
+	if (obs_source_get_type(source) != OBS_SOURCE_TYPE_SCENE)
+		return;
+	for (const char *signal : scene_change_signals) {
+		if (connect)
+			signal_handler_connect(sh, signal, SourceChanged, nullptr);
+		else
+			signal_handler_disconnect(sh, signal, SourceChanged, nullptr);
+	}
+}
+
+static void SourceCreatedForChanges(void *data, calldata_t *cd)
+{
+	ConnectSourceChanges(static_cast<obs_source_t *>(calldata_ptr(cd, "source")), true);
+	SourceChanged(data, cd);
+}
+
+static void EmitSourceChanges(void *param)
 {
 	UNUSED_PARAMETER(param);
-	obs_source_t *source = nullptr;
-	const char *name = obs_data_get_string(request_data, "scene");
-	if (!name || !strlen(name)) {
-		const char *canvas_name = obs_data_get_string(request_data, "canvas");
-		if (strlen(canvas_name)) {
-			obs_canvas_t *canvas = obs_get_canvas_by_name(canvas_name);
-			if (!canvas) {
-				obs_data_set_string(response_data, "error", "canvas not found");
-				obs_data_set_bool(response_data, "success", false);
-				return;
-			}
-			source = obs_canvas_get_source_by_name(canvas, name);
+	changes_queued = false;
+	std::unordered_set<std::string> changed;
+	std::unordered_map<std::string, std::string> removed;
+	{
+		std::lock_guard<std::mutex> lock(changes_mutex);
+		changed.swap(changed_sources);
+		removed.swap(removed_sources);
+	}
+	if (!vendor || (changed.empty() && removed.empty()))
+		return;
+	obs_data_t *event_data = obs_data_create();
+	obs_data_array_t *sources = obs_data_array_create();
+	// The canvases of the changed sources, so a receiver can place them by their canvas_uuid like a snapshot's.
+	std::map<std::string, std::string> canvases;
+	for (const auto &uuid : changed) {
+		obs_source_t *source = obs_get_source_by_uuid(uuid.c_str());
+		if (!source)
+			continue;
+		obs_data_t *data = SaveSourceData(source);
+		obs_data_array_push_back(sources, data);
+		obs_data_release(data);
+		if (obs_canvas_t *canvas = obs_source_get_canvas(source)) {
+			canvases.emplace(obs_canvas_get_uuid(canvas), obs_canvas_get_name(canvas));
 			obs_canvas_release(canvas);
-		} else {
-			source = obs_get_source_by_name(name);
 		}
+		obs_source_release(source);
+	}
+	obs_data_array_t *canvasArray = obs_data_array_create();
+	for (const auto &it : canvases) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "uuid", it.first.c_str());
+		obs_data_set_string(item, "name", it.second.c_str());
+		obs_data_array_push_back(canvasArray, item);
+		obs_data_release(item);
+	}
+	obs_data_array_t *removedArray = obs_data_array_create();
+	for (const auto &it : removed) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "uuid", it.first.c_str());
+		obs_data_set_string(item, "name", it.second.c_str());
+		obs_data_array_push_back(removedArray, item);
+		obs_data_release(item);
+	}
+	obs_data_set_int(event_data, "epoch", (long long)change_epoch);
+	obs_data_set_int(event_data, "seq", (long long)++change_seq);
+	obs_data_set_int(event_data, "time_ms", (long long)WallClockMs());
+	obs_data_set_array(event_data, "canvases", canvasArray);
+	obs_data_set_array(event_data, "sources", sources);
+	obs_data_set_array(event_data, "removed", removedArray);
+	obs_data_array_release(canvasArray);
+	obs_data_array_release(sources);
+	obs_data_array_release(removedArray);
+	obs_websocket_vendor_emit_event(vendor, "sources_changed", event_data);
+	obs_data_release(event_data);
+}
+
+// Coalesces every change since the previous tick into one event, at most once per CHANGE_EVENT_INTERVAL_MS.
+// Serializing happens on the UI thread so the graphics thread only checks a flag.
+static void ChangesTick(void *param, float seconds)
+{
+	UNUSED_PARAMETER(param);
+	UNUSED_PARAMETER(seconds);
+	if (!changes_pending || changes_queued)
+		return;
+	const uint64_t now = os_gettime_ns();
+	if (now - last_changes_emit < (uint64_t)CHANGE_EVENT_INTERVAL_MS * 1000000)
+		return;
+	last_changes_emit = now;
+	changes_pending = false;
+	changes_queued = true;
+	obs_queue_task(OBS_TASK_UI, EmitSourceChanges, nullptr, false);
+}
+
+static void ConnectChangeEvents(bool connect)
+{
+	signal_handler_t *sh = obs_get_signal_handler();
+	if (connect) {
+		signal_handler_connect(sh, "source_create", SourceCreatedForChanges, nullptr);
+		signal_handler_connect(sh, "source_rename", SourceChanged, nullptr);
+		signal_handler_connect(sh, "source_remove", SourceRemoved, nullptr);
+		obs_add_tick_callback(ChangesTick, nullptr);
 	} else {
-		source = obs_frontend_get_current_scene();
+		signal_handler_disconnect(sh, "source_create", SourceCreatedForChanges, nullptr);
+		signal_handler_disconnect(sh, "source_rename", SourceChanged, nullptr);
+		signal_handler_disconnect(sh, "source_remove", SourceRemoved, nullptr);
+		obs_remove_tick_callback(ChangesTick, nullptr);
 	}
-	if (!source) {
-		obs_data_set_string(response_data, "error", "scene not found");
-		obs_data_set_bool(response_data, "success", false);
+	const auto enum_proc = [](void *param, obs_source_t *source) {
+		const bool connect = *static_cast<bool *>(param);
+		ConnectSourceChanges(source, connect);
+		obs_source_enum_filters(
+			source,
+			[](obs_source_t *, obs_source_t *filter, void *param) {
+				ConnectSourceChanges(filter, *static_cast<bool *>(param));
+			},
+			param);
+		return true;
+	};
+	obs_enum_sources(enum_proc, &connect);
+	obs_enum_scenes(enum_proc, &connect);
+}
+
+static bool change_events_connected = false;
+
+static void DisconnectChangeEvents()
+{
+	if (!change_events_connected)
 		return;
+	ConnectChangeEvents(false);
+	change_events_connected = false;
+}
+
+struct MirrorState {
+	uint64_t epoch = 0;
+	uint64_t last_seq = 0;
+	uint64_t applied = 0;
+	uint64_t resyncs = 0;
+	int64_t lag_ms = 0;
+};
+
+static std::mutex mirror_mutex;
+static MirrorState mirror_state;
+// Only touched by MirrorApply, which runs on the UI thread.
+static MirrorUuids mirror_uuids;
+
+// The leader uuids of a snapshot, read before the import, which may drop uuids from the source entries.
+static std::unordered_set<std::string> GetSnapshotUuids(obs_data_t *request_data)
+{
+	std::unordered_set<std::string> present;
+	obs_data_array_t *sources = obs_data_get_array(request_data, "sources");
+	const size_t count = obs_data_array_count(sources);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *data = obs_data_array_item(sources, i);
+		present.emplace(obs_data_get_string(data, "uuid"));
+		obs_data_release(data);
 	}
-	obs_scene_t *scene = obs_scene_from_source(source);
-	if (!scene) {
-		obs_source_release(source);
-		obs_data_set_string(response_data, "error", "not a scene");
+	obs_data_array_release(sources);
+	return present;
+}
+
+// Removes the mirrored sources the leader no longer has, listed under "removed" of the response.
+static void RemoveUnmirrored(const std::unordered_set<std::string> &present, obs_data_t *response_data)
+{
+	obs_data_array_t *removed = obs_data_array_create();
+	for (const auto &it : mirror_uuids.RemoveMissing(present)) {
+		obs_data_t *item = obs_data_create();
+		obs_data_set_string(item, "uuid", it.first.c_str());
+		obs_data_set_string(item, "name", it.second.c_str());
+		obs_data_array_push_back(removed, item);
+		obs_data_release(item);
+	}
+	obs_data_set_array(response_data, "removed", removed);
+	obs_data_array_release(removed);
+}
+
+// Applies one "sources_changed" event (or a "mirror_snapshot" with full set) published by the leader instance.
+// Events must arrive in sequence; on a gap nothing is applied and the caller is told to resync from a snapshot.
+static void MirrorApply(obs_data_t *request_data, obs_data_t *response_data)
+{
+	const uint64_t epoch = (uint64_t)obs_data_get_int(request_data, "epoch");
+	const uint64_t seq = (uint64_t)obs_data_get_int(request_data, "seq");
+	const bool full = obs_data_get_bool(request_data, "full");
+	uint64_t last_seq;
+	{
+		std::lock_guard<std::mutex> lock(mirror_mutex);
+		last_seq = epoch == mirror_state.epoch ? mirror_state.last_seq : 0;
+	}
+	if (!full && last_seq && seq <= last_seq) {
+		obs_data_set_bool(response_data, "skipped", true);
+		obs_data_set_int(response_data, "last_seq", (long long)last_seq);
+		obs_data_set_bool(response_data, "success", true);
+		return;
+	}
+	if (!full && (!last_seq || seq != last_seq + 1)) {
+		blog(LOG_WARNING, "[Source Copy] mirror expected seq %llu, got %llu, resync required",
+		     (unsigned long long)last_seq + 1, (unsigned long long)seq);
+		{
+			std::lock_guard<std::mutex> lock(mirror_mutex);
+			mirror_state.resyncs++;
+		}
+		obs_data_set_bool(response_data, "resync", true);
+		obs_data_set_int(response_data, "last_seq", (long long)last_seq);
+		obs_data_set_string(response_data, "error", "sequence gap");
 		obs_data_set_bool(response_data, "success", false);
 		return;
 	}
-	LoadSource(scene, request_data);
-	obs_source_release(source);
+
+	if (full) {
+		const auto present = GetSnapshotUuids(request_data);
+		obs_data_set_bool(request_data, "update_existing", true);
+		AddCanvases(request_data, response_data, &mirror_uuids);
+		if (obs_data_get_bool(response_data, "success"))
+			RemoveUnmirrored(present, response_data);
+	} else {
+		ApplyScenePatch(request_data, response_data, &mirror_uuids);
+	}
+	if (!obs_data_get_bool(response_data, "success"))
+		return;
+
+	const uint64_t time_ms = (uint64_t)obs_data_get_int(request_data, "time_ms");
+	std::lock_guard<std::mutex> lock(mirror_mutex);
+	mirror_state.epoch = epoch;
+	mirror_state.last_seq = seq;
+	mirror_state.applied++;
+	if (time_ms)
+		mirror_state.lag_ms = (int64_t)(WallClockMs() - time_ms);
+	obs_data_set_int(response_data, "last_seq", (long long)seq);
+	obs_data_set_int(response_data, "lag_ms", mirror_state.lag_ms);
+}
+
+void websocket_mirror_apply(obs_data_t *request_data, obs_data_t *response_data, void *param)
+{
+	UNUSED_PARAMETER(param);
+	obs_data_t *args[] = {request_data, response_data};
+	obs_queue_task(
+		OBS_TASK_UI, [](void *param) {
+			auto args = static_cast<obs_data_t **>(param);
+			MirrorApply(args[0], args[1]);
+		},
+		args, true);
+}
+
+void websocket_mirror_snapshot(obs_data_t *request_data, obs_data_t *response_data, void *param)
+{
+	UNUSED_PARAMETER(request_data);
+	UNUSED_PARAMETER(param);
+	obs_queue_task(
+		OBS_TASK_UI, [](void *param) {
+			auto response_data = static_cast<obs_data_t *>(param);
+			// Flush pending changes first so the snapshot seq covers everything it contains.
+			EmitSourceChanges(nullptr);
+			obs_data_t *data = SaveCanvases();
+			obs_data_apply(response_data, data);
+			obs_data_release(data);
+			obs_data_set_int(response_data, "epoch", (long long)change_epoch);
+			obs_data_set_int(response_data, "seq", (long long)change_seq);
+			obs_data_set_int(response_data, "time_ms", (long long)WallClockMs());
+			obs_data_set_bool(response_data, "full", true);
+			obs_data_set_bool(response_data, "success", true);
+		},
+		response_data, true);
+}
+
+void websocket_mirror_status(obs_data_t *request_data, obs_data_t *response_data, void *param)
+{
+	UNUSED_PARAMETER(request_data);
+	UNUSED_PARAMETER(param);
+	std::lock_guard<std::mutex> lock(mirror_mutex);
+	obs_data_set_int(response_data, "epoch", (long long)mirror_state.epoch);
+	obs_data_set_int(response_data, "last_seq", (long long)mirror_state.last_seq);
+	obs_data_set_int(response_data, "applied", (long long)mirror_state.applied);
+	obs_data_set_int(response_data, "resyncs", (long long)mirror_state.resyncs);
+	obs_data_set_int(response_data, "lag_ms", mirror_state.lag_ms);
 	obs_data_set_bool(response_data, "success", true);
 }
 
@@ -1138,7 +5658,23 @@ void obs_module_post_load(void)
 	obs_websocket_vendor_register_request(vendor, "get_current_scene", websocket_get_current_scene, nullptr);
 	obs_websocket_vendor_register_request(vendor, "get_scene", websocket_get_scene, nullptr);
 	obs_websocket_vendor_register_request(vendor, "add_scene", websocket_add_scene, nullptr);
+	obs_websocket_vendor_register_request(vendor, "add_scene_async", websocket_add_scene_async, nullptr);
+	obs_websocket_vendor_register_request(vendor, "get_scene_diff", websocket_get_scene_diff, nullptr);
+	obs_websocket_vendor_register_request(vendor, "apply_scene_patch", websocket_apply_scene_patch, nullptr);
+	obs_websocket_vendor_register_request(vendor, "get_canvases", websocket_get_canvases, nullptr);
+	obs_websocket_vendor_register_request(vendor, "add_canvases", websocket_add_canvases, nullptr);
+	obs_websocket_vendor_register_request(vendor, "instantiate_template", websocket_instantiate_template, nullptr);
+	obs_websocket_vendor_register_request(vendor, "mirror_apply", websocket_mirror_apply, nullptr);
+	obs_websocket_vendor_register_request(vendor, "mirror_snapshot", websocket_mirror_snapshot, nullptr);
+	obs_websocket_vendor_register_request(vendor, "mirror_status", websocket_mirror_status, nullptr);
 
 	obs_websocket_vendor_register_request(vendor, "get_source", websocket_get_source, nullptr);
 	obs_websocket_vendor_register_request(vendor, "add_source", websocket_add_source, nullptr);
+	obs_websocket_vendor_register_request(vendor, "batch", websocket_batch, nullptr);
+
+	const auto config = get_user_config();
+	if (config && config_get_bool(config, "SourceCopy", "ChangeEvents")) {
+		ConnectChangeEvents(true);
+		change_events_connected = true;
+	}
 }